@@ -54,11 +54,22 @@ public :
 
     /** 
      * Checks if a track has a 3d hit on innermost layer and second innermost layer
+     *
+     * @param hits The hit collection the track hit indices refer to.  If null, 
+     *             the hits are resolved through the track reference array.
      */
         
-    void InnermostLayerCheck(Track* trk, bool& foundL1, bool& foundL2);
+    void InnermostLayerCheck(Track* trk, bool& foundL1, bool& foundL2, 
+            const std::vector<TrackerHit*>* hits = nullptr);
     
-    bool GetParticlesFromVtx(Vertex* vtx, Particle*& ele, Particle*& pos);
+    /**
+     * Gets the electron and positron of a vertex
+     *
+     * @param parts The particle collection the vertex particle indices refer to.  If 
+     *              null, the particles are resolved through the vertex reference array.
+     */
+    bool GetParticlesFromVtx(Vertex* vtx, Particle*& ele, Particle*& pos, 
+            const std::vector<Particle*>* parts = nullptr);
     
     bool MatchToGBLTracks(int ele_id, int pos_id, Track* & ele_trk, Track* & pos_trk, std::vector<Track*>& trks);
     
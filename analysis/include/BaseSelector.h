@@ -5,9 +5,11 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "TH1F.h"
 #include "json.hpp"
+#include "HistoShards.h"
 
 
 //for convenience
@@ -27,7 +29,16 @@ class BaseSelector {
         float getCut(const std::string& cutname) {if (!hasCut(cutname)) {std::cout<<"ERROR "<<cutname<<" cut not implemented"<<std::endl; return -999;} else return cuts[cutname].first;}
         std::map<std::string, std::pair<double,int> > getCuts(){return cuts;}
         void makeCutFlowHisto();
-        std::shared_ptr<TH1F> getCutFlowHisto(){return h_cf_;};
+        //The cut flow of the shard of the current thread, if one is set
+        std::shared_ptr<TH1F> getCutFlowHisto(){
+            int shard = HistoShard::current();
+            return shard >= 0 && shard < (int)cfShards_.size() ? cfShards_[shard] : h_cf_;
+        };
+
+        //Make empty copies of the cut flow for n shards, see HistoManager::makeShards
+        void makeShards(int nShards);
+        //Add the shards to the cut flow, in shard order, and drop them. Call before writing it.
+        void mergeShards();
 
         bool passCut(const std::string& cutname,double val,double weight){return true;};
         bool passCutEq(const std::string& cutname,double val,double weight);
@@ -50,6 +61,7 @@ class BaseSelector {
         bool debug_{false};
         int ncuts_{0};
         std::shared_ptr<TH1F> h_cf_;
+        std::vector<std::shared_ptr<TH1F> > cfShards_;
 
         bool passSelection{false};
 
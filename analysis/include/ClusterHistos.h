@@ -29,6 +29,9 @@ class ClusterHistos : public HistoManager{
 
 
   void FillHistograms(TrackerHit* hit,float weight = 1.);
+
+  //Also gives each shard its own cluster sums
+  virtual void makeShards(int nShards);
   //void BuildAxesMap();
   
   void setBaselineFitsDir(const std::string& baselineFits) {baselineFits_ = baselineFits;};
@@ -46,10 +49,22 @@ class ClusterHistos : public HistoManager{
   std::vector<std::string> half_module_names{};
 
 
-  std::map<std::string, int>    cluSizeMap;
-  std::map<std::string, double> chargeMap;
-  std::map<std::string, double> chargeCorrectedMap;
-  std::map<std::string, double> cluPositionMap;
+  //Sums over the raw hits of a cluster, reset after each fill
+  struct ClusterSums {
+    std::map<std::string, int>    cluSizeMap;
+    std::map<std::string, double> chargeMap;
+    std::map<std::string, double> chargeCorrectedMap;
+    std::map<std::string, double> cluPositionMap;
+  };
+
+  //Sums of the current thread
+  ClusterSums& localSums() {
+    int shard = HistoShard::current();
+    return shard >= 0 && shard < (int)shardSums_.size() ? shardSums_[shard] : sums_;
+  }
+
+  ClusterSums sums_;
+  std::vector<ClusterSums> shardSums_;
   
   std::string baselineFits_{"/nfs/hps3/svtTests/jlabSystem/baselines/fits/"};
   std::string baselineRun_{""};
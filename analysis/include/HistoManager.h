@@ -10,10 +10,24 @@
 #include <map>
 #include <vector>
 #include "json.hpp"
+#include "HistoShards.h"
+#include "HistoTemplates.h"
+#include "NativeHisto.h"
+#include <memory>
+#include <atomic>
 
 //for convenience 
 using json = nlohmann::json;
 
+/**
+ * Handle of a histogram of a HistoManager, resolved once by name with 
+ * get1DHandle or get2DHandle and then used to fill the histogram without 
+ * building its name and looking it up.
+ */
+struct HistoHandle {
+    int index_{-1};
+};
+
 class HistoManager {
 
     public:
@@ -24,15 +38,18 @@ class HistoManager {
         virtual ~HistoManager();
 
         TH3F* get3dHisto(const std::string& str) {
-            return histos3d[str];
+            it3d it = histos3d.find(str);
+            return it != histos3d.end() ? it->second : nullptr;
         }
 
         TH2F* get2dHisto(const std::string& str) {
-            return histos2d[str];
+            it2d it = histos2d.find(str);
+            return it != histos2d.end() ? it->second : nullptr;
         }
 
         TH1F* get1dHisto(const std::string& str) {
-            return histos1d[str];
+            it1d it = histos1d.find(str);
+            return it != histos1d.end() ? it->second : nullptr;
         }
 
         TH1F*  plot1D(const std::string& name,const std::string& xtitle, int nbinsX, float xmin, float xmax);
@@ -73,15 +90,131 @@ class HistoManager {
 
         //Definition of histograms from json config
         virtual void DefineHistos();
+        //Histograms whose key contains makeCopyJsonTag get a copy for each of histoCopyNames
         virtual void DefineHistos(std::vector<std::string> histoCopyNames, std::string makeCopyJsonTag = "default=single_copy");
 
+        /**
+         * Get the handle of a 1D histogram.  Needs to be called after the 
+         * histograms are defined.  The handle of a missing histogram is 
+         * valid, filling it prints the same warning as filling by name.
+         *
+         * @param histoName Name of the histogram, without the name of the manager
+         * @return The handle, valid until the histograms are cleared
+         */
+        HistoHandle get1DHandle(const std::string& histoName);
+
+        /**
+         * Get the handle of a 2D histogram.
+         *
+         * @param histoName Name of the histogram, without the name of the manager
+         * @return The handle, valid until the histograms are cleared
+         */
+        HistoHandle get2DHandle(const std::string& histoName);
+
+        void Fill1DHisto(HistoHandle handle, float value, float weight=1.) {
+            std::vector<TH1F*>& handles = localHandles1d();
+            if (NativeHisto* native = localNative1d(handle))
+                native->Fill(value,weight);
+            else if ((unsigned int)handle.index_ < handles.size() && handles[handle.index_])
+                handles[handle.index_]->Fill(value,weight);
+            else
+                missingHisto("Fill1DHisto", handle, handles.size(), handleNames1d_);
+        }
+
+        void Fill2DHisto(HistoHandle handle, float valuex, float valuey, float weight=1.) {
+            std::vector<TH2F*>& handles = localHandles2d();
+            if (NativeHisto* native = localNative2d(handle))
+                native->Fill(valuex,valuey,weight);
+            else if ((unsigned int)handle.index_ < handles.size() && handles[handle.index_])
+                handles[handle.index_]->Fill(valuex,valuey,weight);
+            else
+                missingHisto("Fill2DHisto", handle, handles.size(), handleNames2d_);
+        }
+
+        /**
+         * Buffer an entry of a 1D histogram.  The entries are added with 
+         * a single FillN call once the buffer is full or when the buffers 
+         * are flushed, which gives the same contents as filling them one 
+         * by one.  Meant for the histograms filled once per hit or per 
+         * particle.  A histogram should be filled either buffered or not, 
+         * so that its entries are added in the order they are filled.
+         * The native histograms are filled directly.
+         */
+        void BufferFill1DHisto(HistoHandle handle, float value, float weight=1.) {
+            if (NativeHisto* native = localNative1d(handle)) {
+                native->Fill(value,weight);
+                return;
+            }
+            std::vector<TH1F*>& handles = localHandles1d();
+            if ((unsigned int)handle.index_ >= handles.size() || !handles[handle.index_]) {
+                missingHisto("BufferFill1DHisto", handle, handles.size(), handleNames1d_);
+                return;
+            }
+            std::vector<FillBuffer>& buffers = localBuffers1d();
+            if ((unsigned int)handle.index_ >= buffers.size())
+                buffers.resize(handles.size());
+            FillBuffer& buffer = buffers[handle.index_];
+            buffer.x_.push_back(value);
+            buffer.w_.push_back(weight);
+            if (buffer.x_.size() >= fillBufferSize_)
+                flushBuffer(handles[handle.index_], buffer);
+        }
+
+        //Buffer an entry of a 2D histogram, see BufferFill1DHisto
+        void BufferFill2DHisto(HistoHandle handle, float valuex, float valuey, float weight=1.) {
+            if (NativeHisto* native = localNative2d(handle)) {
+                native->Fill(valuex,valuey,weight);
+                return;
+            }
+            std::vector<TH2F*>& handles = localHandles2d();
+            if ((unsigned int)handle.index_ >= handles.size() || !handles[handle.index_]) {
+                missingHisto("BufferFill2DHisto", handle, handles.size(), handleNames2d_);
+                return;
+            }
+            std::vector<FillBuffer>& buffers = localBuffers2d();
+            if ((unsigned int)handle.index_ >= buffers.size())
+                buffers.resize(handles.size());
+            FillBuffer& buffer = buffers[handle.index_];
+            buffer.x_.push_back(valuex);
+            buffer.y_.push_back(valuey);
+            buffer.w_.push_back(weight);
+            if (buffer.x_.size() >= fillBufferSize_)
+                flushBuffer(handles[handle.index_], buffer);
+        }
+
+        /**
+         * Add the buffered entries of the current thread to its histograms.
+         * saveHistos flushes all the buffers, so this is only needed to 
+         * look at the histograms while they are being filled.
+         */
+        void flushFillBuffers();
+
+        //Fill by name, looking up the histogram on each call. Prefer the handles in the event loop.
         void Fill1DHisto(const std::string& histoName, float value, float weight=1.);
         void Fill2DHisto(const std::string& histoName, float valuex, float valuey, float weight=1.);
 
+        /**
+         * Make empty copies of the histograms for n shards, so that n 
+         * threads, each one setting its shard with HistoShard::setCurrent, 
+         * can fill them concurrently.  Needs to be called after the 
+         * histograms are defined and before the threads start filling.
+         * The copies are merged into the histograms by saveHistos.
+         *
+         * @param nShards Number of shards
+         */
+        virtual void makeShards(int nShards);
+
+        /**
+         * Add the shards to the histograms, shard by shard, and drop them.
+         * Called by saveHistos, once the threads are done filling.
+         */
+        void mergeShards();
+
         virtual void GetHistosFromFile(TFile* inFile, const std::string& name,const std::string& folder = "");
 
         virtual void saveHistos(TFile* outF = nullptr,std::string folder = "");
         
+        //Load the json config.  A file is only parsed once per job, see HistoTemplates.
         virtual void loadHistoConfig(const std::string histoConfigFile);
         
         virtual void sumw2();
@@ -92,6 +225,17 @@ class HistoManager {
 
         void debugMode(bool debug) {debug_ = debug;}
 
+        /**
+         * Store the histograms defined from the json config in NativeHisto 
+         * arrays instead of TH1F and TH2F, made into TH1F and TH2F with the 
+         * same contents only when they are saved.  Needs to be set before 
+         * DefineHistos.  The native histograms are only filled through the 
+         * Fill methods and are not returned by get1dHisto and get2dHisto.
+         * The 1D histograms with bin labels are always TH1F, since their 
+         * axis can extend.
+         */
+        void nativeBackend(bool native) {native_ = native;}
+
         std::vector<std::string> histos1dNamesfromTFile;
         std::vector<std::string> histos2dNamesfromTFile;
         std::vector<std::string> histos1dNamesfromJson;
@@ -111,11 +255,120 @@ class HistoManager {
         std::map<std::string, TH3F*> histos3d;
         typedef std::map<std::string, TH3F*>::iterator it3d;
 
+        //Histograms filled by the current thread, i.e. the copies of its shard if one is set
+        TH1F* local1dHisto(const std::string& str);
+        TH2F* local2dHisto(const std::string& str);
+        TH3F* local3dHisto(const std::string& str);
+
         bool debug_{false};
         json _h_configs;
         int maxWarnings_{10};
-        int printWarnings_{0};
-        bool doPrintWarnings_{true};
+        unsigned int fillBufferSize_{1024};
+        //Counted from the threads filling the shards
+        std::atomic<int> printWarnings_{0};
+        std::atomic<bool> doPrintWarnings_{true};
+
+        //Count a warning of method, true if it is to be printed
+        bool countWarning(const std::string& method);
+
+    private:
+
+        //Define a histogram from a template of the config
+        void defineHisto(const HistoTemplate& tmpl, const std::string& name);
+
+        //Parsed config loaded by loadHistoConfig
+        std::shared_ptr<HistoTemplates> templates_;
+
+        //Make the TH1F and TH2F of the native histograms, called by saveHistos
+        void makeNativeHistos();
+
+        //Native histograms, by full name, and their shards and handles
+        bool native_{false};
+        std::map<std::string, NativeHisto*> natives1d_;
+        std::map<std::string, NativeHisto*> natives2d_;
+        HistoShards<NativeHisto> nativeShards1d_;
+        HistoShards<NativeHisto> nativeShards2d_;
+        std::vector<NativeHisto*> nativeHandles1d_;
+        std::vector<NativeHisto*> nativeHandles2d_;
+        std::vector<std::vector<NativeHisto*> > shardNativeHandles1d_;
+        std::vector<std::vector<NativeHisto*> > shardNativeHandles2d_;
+
+        //Native histogram of a handle filled by the current thread, nullptr if not native
+        NativeHisto* localNative1d(HistoHandle handle) {
+            int shard = HistoShard::current();
+            std::vector<NativeHisto*>& natives = shard >= 0 && shard < (int)shardNativeHandles1d_.size() ? 
+                shardNativeHandles1d_[shard] : nativeHandles1d_;
+            return (unsigned int)handle.index_ < natives.size() ? natives[handle.index_] : nullptr;
+        }
+
+        NativeHisto* localNative2d(HistoHandle handle) {
+            int shard = HistoShard::current();
+            std::vector<NativeHisto*>& natives = shard >= 0 && shard < (int)shardNativeHandles2d_.size() ? 
+                shardNativeHandles2d_[shard] : nativeHandles2d_;
+            return (unsigned int)handle.index_ < natives.size() ? natives[handle.index_] : nullptr;
+        }
+
+        //Native histogram filled by the current thread, by full name
+        NativeHisto* localNative1dHisto(const std::string& str);
+        NativeHisto* localNative2dHisto(const std::string& str);
+
+        //Entries buffered by BufferFill1DHisto and BufferFill2DHisto, y_ is only used in 2D
+        struct FillBuffer {
+            std::vector<double> x_;
+            std::vector<double> y_;
+            std::vector<double> w_;
+        };
+
+        void flushBuffer(TH1F* histo, FillBuffer& buffer);
+        void flushBuffer(TH2F* histo, FillBuffer& buffer);
+        void flushBuffers(std::vector<TH1F*>& handles, std::vector<FillBuffer>& buffers);
+        void flushBuffers(std::vector<TH2F*>& handles, std::vector<FillBuffer>& buffers);
+
+        //Print the warning of a fill of a missing histogram
+        void missingHisto(const std::string& method, HistoHandle handle, std::size_t nHandles, 
+                const std::vector<std::string>& names);
+
+        //Histograms and full names of the handles. The histogram is null if not defined.
+        std::vector<TH1F*> handles1d_;
+        std::vector<std::string> handleNames1d_;
+        std::map<std::string, int> handleIndices1d_;
+
+        std::vector<TH2F*> handles2d_;
+        std::vector<std::string> handleNames2d_;
+        std::map<std::string, int> handleIndices2d_;
+
+        //Copies of the histograms filled by each shard, and their handles
+        HistoShards<TH1F> shards1d_;
+        HistoShards<TH2F> shards2d_;
+        HistoShards<TH3F> shards3d_;
+        std::vector<std::vector<TH1F*> > shardHandles1d_;
+        std::vector<std::vector<TH2F*> > shardHandles2d_;
+
+        //Buffers of the handles, per shard
+        std::vector<FillBuffer> buffers1d_;
+        std::vector<FillBuffer> buffers2d_;
+        std::vector<std::vector<FillBuffer> > shardBuffers1d_;
+        std::vector<std::vector<FillBuffer> > shardBuffers2d_;
+
+        std::vector<FillBuffer>& localBuffers1d() {
+            int shard = HistoShard::current();
+            return shard >= 0 && shard < (int)shardBuffers1d_.size() ? shardBuffers1d_[shard] : buffers1d_;
+        }
+
+        std::vector<FillBuffer>& localBuffers2d() {
+            int shard = HistoShard::current();
+            return shard >= 0 && shard < (int)shardBuffers2d_.size() ? shardBuffers2d_[shard] : buffers2d_;
+        }
+
+        std::vector<TH1F*>& localHandles1d() {
+            int shard = HistoShard::current();
+            return shard >= 0 && shard < (int)shardHandles1d_.size() ? shardHandles1d_[shard] : handles1d_;
+        }
+
+        std::vector<TH2F*>& localHandles2d() {
+            int shard = HistoShard::current();
+            return shard >= 0 && shard < (int)shardHandles2d_.size() ? shardHandles2d_[shard] : handles2d_;
+        }
 
 };
 
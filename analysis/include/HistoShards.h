@@ -0,0 +1,123 @@
+#ifndef HISTOSHARDS_H
+#define HISTOSHARDS_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Shard of the histograms filled by the current thread.  The histogram
+ * managers and selectors fill the copies of this shard instead of the
+ * master histograms, so that several threads can fill them without locks.
+ * A thread which doesn't set a shard fills the master histograms.
+ */
+class HistoShard {
+
+    public:
+
+        /** @return The shard of the current thread, -1 if none is set */
+        static int current();
+
+        /** Set the shard of the current thread, -1 to fill the master histograms */
+        static void setCurrent(int shard);
+
+        /**
+         * Set the shard of the current thread until it goes out of scope.
+         */
+        class Scope {
+            public:
+                Scope(int shard) : previous_(current()) { setCurrent(shard); }
+                ~Scope() { setCurrent(previous_); }
+                Scope(const Scope&) = delete;
+                Scope& operator=(const Scope&) = delete;
+            private:
+                int previous_;
+        };
+};
+
+/**
+ * Empty copies of a set of histograms, one per shard, reduced into the
+ * master histograms in a fixed order, i.e. shard by shard and by name
+ * within a shard, so that the merged histograms don't depend on the
+ * scheduling of the threads.
+ *
+ * The shards are made and merged by a single thread, while no other thread
+ * fills them.
+ */
+template <class H>
+class HistoShards {
+
+    public:
+
+        ~HistoShards() { clear(); }
+
+        /**
+         * Make n empty copies of the histograms.  Any previous copies are
+         * dropped without being merged.
+         *
+         * @param histos The master histograms, by name
+         * @param nShards Number of shards
+         */
+        void make(const std::map<std::string, H*>& histos, int nShards) {
+            clear();
+            shards_.resize(nShards > 0 ? nShards : 0);
+            for (std::map<std::string, H*>& shard : shards_) {
+                for (const auto& histo : histos) {
+                    if (!histo.second)
+                        continue;
+                    H* copy = (H*)histo.second->Clone();
+                    copy->SetDirectory(0);
+                    copy->Reset();
+                    shard[histo.first] = copy;
+                }
+            }
+        }
+
+        /**
+         * Add the copies to the master histograms and drop them.
+         *
+         * @param histos The master histograms, by name
+         */
+        void merge(std::map<std::string, H*>& histos) {
+            for (std::map<std::string, H*>& shard : shards_) {
+                for (const auto& copy : shard) {
+                    auto master = histos.find(copy.first);
+                    if (master != histos.end() && master->second)
+                        master->second->Add(copy.second);
+                }
+            }
+            clear();
+        }
+
+        /** Drop the copies without merging them */
+        void clear() {
+            for (std::map<std::string, H*>& shard : shards_) {
+                for (auto& copy : shard)
+                    delete copy.second;
+            }
+            shards_.clear();
+        }
+
+        /** @return The number of shards */
+        int size() const { return shards_.size(); }
+
+        /** @return The copy of a histogram in a shard, nullptr if missing */
+        H* get(int shard, const std::string& name) const {
+            if (shard < 0 || shard >= (int)shards_.size())
+                return nullptr;
+            auto copy = shards_[shard].find(name);
+            return copy != shards_[shard].end() ? copy->second : nullptr;
+        }
+
+        /** @return The copies of the shard of the current thread, nullptr if none */
+        std::map<std::string, H*>* local() {
+            int shard = HistoShard::current();
+            return shard >= 0 && shard < (int)shards_.size() ? &shards_[shard] : nullptr;
+        }
+
+    private:
+
+        std::vector<std::map<std::string, H*> > shards_;
+};
+
+#endif //HISTOSHARDS_H
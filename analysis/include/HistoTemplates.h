@@ -0,0 +1,68 @@
+#ifndef HISTOTEMPLATES_H
+#define HISTOTEMPLATES_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "json.hpp"
+
+//for convenience 
+using json = nlohmann::json;
+
+/**
+ * Binning and titles of a histogram of a json config, read once so that 
+ * the histograms can be defined without going through the json again.
+ */
+struct HistoTemplate {
+    std::string key_;
+    int dim_{1};
+    std::string xtitle_;
+    int binsX_{0};
+    float minX_{0.};
+    float maxX_{0.};
+    std::string ytitle_;
+    int binsY_{0};
+    float minY_{0.};
+    float maxY_{0.};
+    //Bin labels of a 1D histogram, empty if none
+    std::vector<std::string> labels_;
+};
+
+/**
+ * Histogram configs, parsed once per file and shared by all the histogram 
+ * managers loading the same file, e.g. the copies of the histograms of 
+ * each selection region.
+ */
+class HistoTemplates {
+
+    public:
+
+        /**
+         * Get the parsed config of a file, reading it on the first call.
+         *
+         * @param configFile Path of the json config
+         */
+        static std::shared_ptr<HistoTemplates> get(const std::string& configFile);
+
+        const json& config() const { return config_; }
+
+        /**
+         * The templates of the 1D ("_h") and 2D ("_hh") histograms of the 
+         * config, in the order of the config, built on the first call.
+         */
+        const std::vector<HistoTemplate>& templates();
+
+    private:
+
+        HistoTemplates(const std::string& configFile);
+
+        std::string configFile_;
+        json config_;
+        std::vector<HistoTemplate> templates_;
+        bool built_{false};
+        std::mutex mutex_;
+};
+
+#endif //HISTOTEMPLATES_H
@@ -26,6 +26,24 @@ class MCAnaHistos : public HistoManager {
         void FillMCTrackerHits(std::vector<MCTrackerHit*> *mcTrkrHits, float weight = 1.);
         void FillMCEcalHits(std::vector<MCEcalHit*> *mcEcalHits, float weight = 1.);
 
+        //Also drops the histogram handles
+        virtual void Clear();
+
+        //Resolves the handles before the shards are filled
+        virtual void makeShards(int nShards);
+
+    private:
+
+        //Handles of the histograms filled once per particle or hit
+        struct Handles {
+            HistoHandle partsEnergy, partsEnergyLow, trkrHitEdep, trkrHitPdgId, ecalHitEnergy;
+        };
+
+        const Handles& getHandles();
+
+        Handles handles_;
+        bool handlesResolved_{false};
+
 };
 
 #endif //MCANAHISTOS_H
@@ -0,0 +1,116 @@
+#ifndef NATIVEHISTO_H
+#define NATIVEHISTO_H
+
+#include "TH1.h"
+#include "TH2.h"
+#include <string>
+#include <vector>
+
+/**
+ * Fixed binning 1D or 2D histogram stored in plain arrays, filled without
+ * the virtual calls and the bookkeeping of a TH1.  Follows the same rules
+ * as TH1F::Fill and TH2F::Fill, i.e. float bin contents, double sums of the
+ * squared weights and statistics of the entries in range, so that the TH1F
+ * or TH2F made from it by copyTo is the same as if it had been filled
+ * directly.
+ *
+ * Clone, SetDirectory, Reset and Add mirror the TH1 methods so that the
+ * native histograms can be sharded with HistoShards.
+ */
+class NativeHisto {
+
+    public:
+
+        NativeHisto(const std::string& name, const std::string& xtitle, int nbinsX, float xmin, float xmax,
+                const std::string& ytitle = "");
+
+        NativeHisto(const std::string& name,
+                const std::string& xtitle, int nbinsX, float xmin, float xmax,
+                const std::string& ytitle, int nbinsY, float ymin, float ymax);
+
+        void Fill(double x, double w) {
+            int bin = x_.findBin(x);
+            entries_++;
+            sumw2_[bin] += w*w;
+            sumw_[bin] += float(w);
+            double* stats = (bin == 0 || bin > x_.nbins_) ? overflowStats_ : stats_;
+            stats[0] += w;
+            stats[1] += w*w;
+            stats[2] += w*x;
+            stats[3] += w*x*x;
+        }
+
+        void Fill(double x, double y, double w) {
+            int binx = x_.findBin(x);
+            int biny = y_.findBin(y);
+            int bin = biny*(x_.nbins_+2) + binx;
+            entries_++;
+            sumw2_[bin] += w*w;
+            sumw_[bin] += float(w);
+            double* stats = (binx == 0 || binx > x_.nbins_ || biny == 0 || biny > y_.nbins_) ? overflowStats_ : stats_;
+            stats[0] += w;
+            stats[1] += w*w;
+            stats[2] += w*x;
+            stats[3] += w*x*x;
+            stats[4] += w*y;
+            stats[5] += w*y*y;
+            stats[6] += w*x*y;
+        }
+
+        NativeHisto* Clone() const { return new NativeHisto(*this); }
+
+        //Not attached to any directory, kept for HistoShards
+        void SetDirectory(void*) {}
+
+        void Reset();
+
+        void Add(const NativeHisto* other);
+
+        int GetDimension() const { return dim_; }
+
+        const std::string& getName() const { return name_; }
+
+        /**
+         * Make the ROOT histogram, with the same name, titles and binning
+         * as HistoManager::plot1D or plot2D, and copy the contents into it.
+         */
+        TH1F* makeTH1F() const;
+        TH2F* makeTH2F() const;
+
+    private:
+
+        struct Axis {
+            int nbins_{1};
+            double min_{0.};
+            double max_{1.};
+            std::string title_;
+
+            //Same as TAxis::FindFixBin for fixed bins
+            int findBin(double x) const {
+                if (x < min_)
+                    return 0;
+                if (!(x < max_))
+                    return nbins_+1;
+                return 1 + int(nbins_*(x-min_)/(max_-min_));
+            }
+        };
+
+        //Copy the contents, the statistics and the entries into a histogram with the same binning
+        void copyTo(TH1* histo, float* contents) const;
+
+        std::string name_;
+        int dim_{1};
+        Axis x_;
+        Axis y_;
+
+        std::vector<float> sumw_;
+        std::vector<double> sumw2_;
+        double entries_{0.};
+
+        //Sums of w, w^2, wx, wx^2, wy, wy^2 and wxy as in TH1::GetStats,
+        //of the entries in range and of the under- and overflows
+        double stats_[7]{};
+        double overflowStats_[7]{};
+};
+
+#endif //NATIVEHISTO_H
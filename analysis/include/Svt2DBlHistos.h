@@ -12,6 +12,7 @@
 
 #include "ModuleMapper.h"
 
+#include <atomic>
 #include <string>
 
 
@@ -24,10 +25,27 @@ class Svt2DBlHistos : public HistoManager{
         void DefineHistos();
         void FillHistograms(std::vector<RawSvtHit*> *rawSvtHits_,float weight = 1.);
 
+        //Also drops the hybrid handles
+        virtual void Clear();
+
+        //Resolves the hybrid handles before the shards are filled
+        virtual void makeShards(int nShards);
+
 
     private:
 
-        int Event_number=0;
+        //Handles of the histograms of a hybrid
+        struct HybridHandles {
+            HistoHandle hitN, adc0, adc3;
+        };
+
+        //Resolve the handles of all hybrids, by module and layer, on first use
+        void resolveHybridHandles();
+
+        HybridHandles hybridHandles_[4][15];
+        bool hybridHandlesResolved_{false};
+
+        std::atomic<int> Event_number{0};
         int debug_ = 1;
 
         TH1F* svtCondHisto{nullptr};  
@@ -6,6 +6,7 @@
 #include "TrackerHit.h"
 #include "Vertex.h"
 #include "Particle.h"
+#include <map>
 #include <string>
 #include <vector>
 
@@ -29,8 +30,9 @@ class TrackHistos : public HistoManager {
         void Fill1DTrack(Track* track, float weight = 1., const std::string& trkname = "");
         void Fill2DTrack(Track* track, float weight = 1., const std::string& trkname = "");
 
-        //This should probably go somewhere else
-        void FillResidualHistograms(Track* track, int ly, double res, double sigma);
+        //This should probably go somewhere else. hits is the collection the track hit indices refer to, if any.
+        void FillResidualHistograms(Track* track, int ly, double res, double sigma, 
+                const std::vector<TrackerHit*>* hits = nullptr);
         
         void Fill1DVertex(Vertex* vtx, float weight = 1.);
         
@@ -47,8 +49,53 @@ class TrackHistos : public HistoManager {
         void FillTrackComparisonHistograms(Track* track_x, Track* track_y, float weight = 1.);
         void doTrackComparisonPlots(bool doplots) {doTrkCompPlots = doplots;};
 
+        //Also drops the histogram handles
+        virtual void Clear();
+
+        //Resolves the handles of the track prefixes, vertex and residual layers
+        //filled by the processors, so that the shards don't add them concurrently
+        virtual void makeShards(int nShards);
+
     private:
 
+        //Handles of the track histograms with a given name prefix
+        struct TrackHandles {
+            HistoHandle d0, phi, omega, pT, p, invpT, tanLambda, z0, time, chi2, chi2ndf, nShared, nHits2d;
+            HistoHandle sharingHits, strategy, type;
+            HistoHandle tanlambda_vs_phi0, d0_vs_p, d0_vs_phi0, d0_vs_tanlambda;
+            HistoHandle z0_vs_p, phi0_vs_p, z0_vs_phi0, z0_vs_tanlambda;
+            HistoHandle d0_res, phi_res, omega_res, tanLambda_res, z0_res, p_res, invpT_res, invpT_res_percent;
+            HistoHandle px_res, py_res, pz_res;
+            HistoHandle d0_pull, phi_pull, omega_pull, tanLambda_pull, z0_pull;
+        };
+
+        //Handles of the vertex histograms
+        struct VertexHandles {
+            HistoHandle chi2, XY, X, Y, Z, XY_svt, X_svt, Y_svt, Z_svt;
+            HistoHandle sigma_X, sigma_Y, sigma_Z, InvM, InvMErr, px, py, pz, p;
+            HistoHandle ele_p, pos_p, ele_clusE, pos_clusE, ele_EoP, pos_EoP, EoP;
+            HistoHandle Pmiss, Esum, EsumClus, EClus, InvM_eleP, InvM_posP, Psum, PtAsym;
+            HistoHandle thetax_v0, thetax_pos, thetay_pos, thetay_miss, thetay_diff;
+            HistoHandle InvM_z, InvM_svt_z, p_svt_z, p_svt_x, p_svt_y, svt_y_svt_z;
+            HistoHandle p_sigmaZ, p_sigmaX, p_sigmaY;
+        };
+
+        //Handles of the residual histograms of a layer
+        struct ResidualHandles {
+            HistoHandle res, res_vsp, res_vsy;
+            HistoHandle res_top, res_top_vsp, res_bot, res_bot_vsp;
+        };
+
+        //Resolve the handles on first use, once the histograms are defined
+        const TrackHandles& getTrackHandles(const std::string& trkname);
+        const VertexHandles& getVertexHandles();
+        const ResidualHandles& getResidualHandles(int ly);
+
+        std::map<std::string, TrackHandles> trackHandles_;
+        std::map<int, ResidualHandles> residualHandles_;
+        VertexHandles vertexHandles_;
+        bool vertexHandlesResolved_{false};
+
         // Vertices
         std::vector<std::string> vPs{"vtx_chi2", "vtx_X", "vtx_Y", "vtx_Z", "vtx_sigma_X","vtx_sigma_Y","vtx_sigma_Z","vtx_InvM","vtx_InvMErr"};
 
@@ -23,10 +23,13 @@ std::string AnaHelpers::getFileName(std::string filePath, bool withExtension)
     return "";
 }
 
-void AnaHelpers::InnermostLayerCheck(Track* trk, bool& foundL1, bool& foundL2) {
+void AnaHelpers::InnermostLayerCheck(Track* trk, bool& foundL1, bool& foundL2, 
+        const std::vector<TrackerHit*>* hits) {
     int innerCount = 0;
-    for (int ihit=0; ihit<trk->getSvtHits()->GetEntries();++ihit) {
-        TrackerHit* hit3d = (TrackerHit*) trk->getSvtHits()->At(ihit);
+    for (int ihit=0; ihit<trk->getNHitLinks();++ihit) {
+        TrackerHit* hit3d = trk->getHit(ihit, hits);
+        if (!hit3d)
+            continue;
         if (hit3d->getLayer() == 0 ) {
             innerCount++;
         }
@@ -64,25 +67,29 @@ bool AnaHelpers::MatchToGBLTracks(int ele_id, int pos_id, Track* & ele_trk, Trac
 
 
 //TODO clean bit up 
-bool AnaHelpers::GetParticlesFromVtx(Vertex* vtx, Particle*& ele, Particle*& pos) {
+bool AnaHelpers::GetParticlesFromVtx(Vertex* vtx, Particle*& ele, Particle*& pos, 
+        const std::vector<Particle*>* parts) {
 
 
     bool foundele = false;
     bool foundpos = false;
 
-    for (int ipart = 0; ipart < vtx->getParticles()->GetEntries(); ++ipart) {
+    for (int ipart = 0; ipart < vtx->getNParticleLinks(); ++ipart) {
 
+        Particle* part = vtx->getParticle(ipart, parts);
+        if (!part)
+            continue;
 
-        int pdg_id = ((Particle*)vtx->getParticles()->At(ipart))->getPDG();
+        int pdg_id = part->getPDG();
         if (debug_) std::cout<<"In Loop "<<pdg_id<< " "<< ipart<<std::endl;
 
         if (pdg_id == 11) {
-            ele =  ((Particle*)vtx->getParticles()->At(ipart));
+            ele = part;
             foundele=true;
             if (debug_) std::cout<<"found ele "<< (int)foundele<<std::endl;
         }
         else if (pdg_id == -11) {
-            pos = (Particle*)vtx->getParticles()->At(ipart);
+            pos = part;
             foundpos=true;
             if  (debug_) std::cout<<"found pos "<<(int)foundpos<<std::endl;
 
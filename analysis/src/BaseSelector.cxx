@@ -75,6 +75,24 @@ void BaseSelector::makeCutFlowHisto() {
     }
 }
 
+void BaseSelector::makeShards(int nShards) {
+    cfShards_.clear();
+    if (!h_cf_)
+        return;
+    for (int shard = 0; shard < nShards; ++shard) {
+        std::shared_ptr<TH1F> copy((TH1F*)h_cf_->Clone());
+        copy->SetDirectory(0);
+        copy->Reset();
+        cfShards_.push_back(copy);
+    }
+}
+
+void BaseSelector::mergeShards() {
+    for (unsigned int shard = 0; shard < cfShards_.size(); ++shard)
+        h_cf_->Add(cfShards_[shard].get());
+    cfShards_.clear();
+}
+
 
 //TODO Clean up logic
 bool BaseSelector::passCutEq(const std::string& cutname, double val, double w) {
@@ -85,7 +103,7 @@ bool BaseSelector::passCutEq(const std::string& cutname, double val, double w) {
             return false;
         }
         else {
-            h_cf_->Fill((double)(cuts[cutname].second + 1), w);
+            getCutFlowHisto()->Fill((double)(cuts[cutname].second + 1), w);
             passSelection = passSelection && true;
         }
     }
@@ -101,7 +119,7 @@ bool BaseSelector::passCutLt(const std::string& cutname, double val, double w) {
             return false;
         }
         else {
-            h_cf_->Fill((double)(cuts[cutname].second + 1), w);
+            getCutFlowHisto()->Fill((double)(cuts[cutname].second + 1), w);
             passSelection = passSelection && true;
         }
     }
@@ -116,7 +134,7 @@ bool BaseSelector::passCutGt(const std::string& cutname, double val, double w) {
             return false;
         }
         else {
-            h_cf_->Fill((double)(cuts[cutname].second + 1), w);
+            getCutFlowHisto()->Fill((double)(cuts[cutname].second + 1), w);
             passSelection = passSelection && true;
         }
     }
@@ -19,10 +19,11 @@ ClusterHistos::~ClusterHistos() {
        }
        */
 
-    cluSizeMap.clear();
-    chargeMap.clear();
-    chargeCorrectedMap.clear();
-    cluPositionMap.clear();
+    sums_.cluSizeMap.clear();
+    sums_.chargeMap.clear();
+    sums_.chargeCorrectedMap.clear();
+    sums_.cluPositionMap.clear();
+    shardSums_.clear();
     for (std::map<std::string, TGraphErrors*>::iterator it = baselineGraphs.begin(); 
             it!=baselineGraphs.end(); ++it) {
         if (it->second) {
@@ -49,10 +50,10 @@ void ClusterHistos::Define1DHistos() {
         histos1d[h_name] = plot1D(h_name,"charge",100,0,10000);
         h_name = m_name+"_"+half_module_names[ihm]+"_cluSize";
         histos1d[h_name] = plot1D(h_name,"cluSize",10,0,10);
-        cluSizeMap[h_name]          = 0.;
-        chargeMap[h_name]           = 0.;
-        chargeCorrectedMap[h_name]  = 0.;
-        cluPositionMap[h_name]      = 0.;
+        sums_.cluSizeMap[h_name]          = 0.;
+        sums_.chargeMap[h_name]           = 0.;
+        sums_.chargeCorrectedMap[h_name]  = 0.;
+        sums_.cluPositionMap[h_name]      = 0.;
     }//half module plots
 }
 
@@ -234,22 +235,29 @@ bool ClusterHistos::LoadBaselineHistos(const std::string& baselinesIn) {
 
 
 
+void ClusterHistos::makeShards(int nShards) {
+    HistoManager::makeShards(nShards);
+    shardSums_.assign(nShards > 0 ? nShards : 0, sums_);
+}
+
 void ClusterHistos::FillHistograms(TrackerHit* hit,float weight) {
 
-    TRefArray* rawhits_ = hit->getRawHits();
+    ClusterSums& sums = localSums();
     //int  iv      = -1;   // 0 top, 1 bottom
     //int  it      = -1;   // 0 axial, 1 stereo
     //int  ily     = -1;   // 0-6
 
     //TODO do this better
 
-    //std::cout<<"Size:" <<rawhits_->GetEntries()<<std::endl;
+    //std::cout<<"Size:" <<hit->getNRawHitLinks()<<std::endl;
 
     std::string swTag = "";
 
-    for (unsigned int irh = 0; irh < rawhits_->GetEntries(); ++irh) {
+    for (int irh = 0; irh < hit->getNRawHitLinks(); ++irh) {
 
-        RawSvtHit * rawhit  = static_cast<RawSvtHit*>(rawhits_->At(irh));
+        RawSvtHit * rawhit  = hit->getRawHit(irh);
+        if (!rawhit)
+            continue;
         //rawhit layers go from 1 to 14. Example: RawHit->Layer1 is layer0 axial on top and layer0 stereo in bottom.
 
         swTag = "ly"+std::to_string(rawhit->getLayer())+"_m"+std::to_string(rawhit->getModule());
@@ -260,7 +268,7 @@ void ClusterHistos::FillHistograms(TrackerHit* hit,float weight) {
         //std::cout<<"----"<<std::endl;
 
         //2D cluster charge
-        chargeMap     [m_name+"_"+key+"_charge"]  += rawhit->getAmp(0);
+        sums.chargeMap     [m_name+"_"+key+"_charge"]  += rawhit->getAmp(0);
 
         double baseline = -999;
         double strip    = -999;
@@ -274,35 +282,35 @@ void ClusterHistos::FillHistograms(TrackerHit* hit,float weight) {
         float sample0 = baseline - rawhit->getADCs()[0];
         float sample1 = baseline - rawhit->getADCs()[1]; 
 
-        chargeCorrectedMap[m_name+"_"+key+"_charge"]  += (rawhit->getAmp(0) + sample0);
+        sums.chargeCorrectedMap[m_name+"_"+key+"_charge"]  += (rawhit->getAmp(0) + sample0);
 
-        histos2d[m_name+"_"+key+"_sample0_vs_Amp"]->Fill(rawhit->getAmp(0),sample0,weight);
-        histos2d[m_name+"_"+key+"_sample1_vs_Amp"]->Fill(rawhit->getAmp(0),sample1,weight);
+        local2dHisto(m_name+"_"+key+"_sample0_vs_Amp")->Fill(rawhit->getAmp(0),sample0,weight);
+        local2dHisto(m_name+"_"+key+"_sample1_vs_Amp")->Fill(rawhit->getAmp(0),sample1,weight);
 
-        histos2d[m_name+"_"+key+"_sample0_vs_stripPos"]->Fill(rawhit->getStrip(),-sample0,weight);
-        histos2d[m_name+"_"+key+"_sample1_vs_stripPos"]->Fill(rawhit->getStrip(),-sample1,weight);
+        local2dHisto(m_name+"_"+key+"_sample0_vs_stripPos")->Fill(rawhit->getStrip(),-sample0,weight);
+        local2dHisto(m_name+"_"+key+"_sample1_vs_stripPos")->Fill(rawhit->getStrip(),-sample1,weight);
 
 
         //2D cluster size1
-        cluSizeMap    [m_name+"_"+key+"_cluSize"] ++;
+        sums.cluSizeMap    [m_name+"_"+key+"_cluSize"] ++;
 
         //2D Weighted position numerator
-        cluPositionMap[m_name+"_"+key+"_charge"]  += rawhit->getAmp(0)*rawhit->getStrip();
+        sums.cluPositionMap[m_name+"_"+key+"_charge"]  += rawhit->getAmp(0)*rawhit->getStrip();
         //std::cout<<"rawhit->getStrip()::"<<rawhit->getStrip()<<std::endl;
     }
 
     //TODO make this more efficient: useless to loop all over the possibilities
 
-    for (std::map<std::string, int>::iterator it = cluSizeMap.begin(); it!=cluSizeMap.end(); ++it ) {
+    for (std::map<std::string, int>::iterator it = sums.cluSizeMap.begin(); it!=sums.cluSizeMap.end(); ++it ) {
         if (it->second != 0) {
             //std::cout<<"Filling..."<<it->first<<" "<<histos1d[it->first]<<std::endl;
-            histos1d[it->first]->Fill(it->second,weight);
-            cluSizeMap[it->first]= 0;
+            local1dHisto(it->first)->Fill(it->second,weight);
+            sums.cluSizeMap[it->first]= 0;
         }
     }// fills the maps
 
     //TODO make this more efficient: useless to loop all over the possibilities
-    for (std::map<std::string, double>::iterator it = chargeMap.begin(); it!=chargeMap.end(); ++it ) {
+    for (std::map<std::string, double>::iterator it = sums.chargeMap.begin(); it!=sums.chargeMap.end(); ++it ) {
         //TODO make it better
         //Avoid comparing to 0.0 and check if there is a charge deposit on this 
         if (it->second > 1e-6) {
@@ -313,43 +321,43 @@ void ClusterHistos::FillHistograms(TrackerHit* hit,float weight) {
             //it->second holds the charge
             //it->first =  charge histogram name.
             double charge = it->second;
-            histos1d[it->first]->Fill(charge,weight);
-            double weighted_pos = cluPositionMap[it->first] / (charge);
-            double chargeCorrected = chargeCorrectedMap[it->first];
+            local1dHisto(it->first)->Fill(charge,weight);
+            double weighted_pos = sums.cluPositionMap[it->first] / (charge);
+            double chargeCorrected = sums.chargeCorrectedMap[it->first];
             //std::cout<<"weighted pos "<<weighted_pos<<std::endl;
-            histos2d[it->first+"_vs_stripPos"]->Fill(weighted_pos,charge,weight);
+            local2dHisto(it->first+"_vs_stripPos")->Fill(weighted_pos,charge,weight);
 
             // Fill the baseline corrected charge
-            histos2d[it->first+"_corrected_vs_stripPos"]->Fill(weighted_pos,chargeCorrected,weight);
+            local2dHisto(it->first+"_corrected_vs_stripPos")->Fill(weighted_pos,chargeCorrected,weight);
 
             //Fill local vs global
 
-            histos2d[plotID+"_stripPos_vs_gy"]->Fill(fabs(hit->getGlobalY()),weighted_pos,weight);
+            local2dHisto(plotID+"_stripPos_vs_gy")->Fill(fabs(hit->getGlobalY()),weighted_pos,weight);
 
             double globRad = sqrt(hit->getGlobalX() * hit->getGlobalX() + hit->getGlobalY()+hit->getGlobalY());
-            histos2d[it->first+"_vs_globRad"]->Fill(globRad,charge,weight);
+            local2dHisto(it->first+"_vs_globRad")->Fill(globRad,charge,weight);
 
 
-            chargeMap[it->first]          = 0.0;
-            chargeCorrectedMap[it->first] = 0.0;
-            cluPositionMap[it->first]     = 0.0;
+            sums.chargeMap[it->first]          = 0.0;
+            sums.chargeCorrectedMap[it->first] = 0.0;
+            sums.cluPositionMap[it->first]     = 0.0;
 
         } 
     }
-    histos1d[m_name+"_gz"]->Fill(hit->getGlobalZ(),weight);
+    local1dHisto(m_name+"_gz")->Fill(hit->getGlobalZ(),weight);
     //1D
     //histos1d[m_name+"_charge"]->Fill(hit->getCharge(),weight);
     //2D
     if (hit->getGlobalZ() < 50 && hit->getGlobalZ() > 40) {
-        histos2d[m_name+"_gy_L0T_vs_gx"]->Fill(hit->getGlobalX(),fabs(hit->getGlobalY()),weight);
-        histos2d[m_name+"_charge_L0T_vs_gx"]->Fill(hit->getGlobalX(),hit->getCharge(),weight);
-        histos2d[m_name+"_charge_L0T_vs_gy"]->Fill(fabs(hit->getGlobalY()),hit->getCharge(),weight);
+        local2dHisto(m_name+"_gy_L0T_vs_gx")->Fill(hit->getGlobalX(),fabs(hit->getGlobalY()),weight);
+        local2dHisto(m_name+"_charge_L0T_vs_gx")->Fill(hit->getGlobalX(),hit->getCharge(),weight);
+        local2dHisto(m_name+"_charge_L0T_vs_gy")->Fill(fabs(hit->getGlobalY()),hit->getCharge(),weight);
 
     }
 
     if (hit->getGlobalZ() < 60 && hit->getGlobalZ() > 55) {
-        histos2d[m_name+"_gy_L0B_vs_gx"]->Fill(hit->getGlobalX(),fabs(hit->getGlobalY()),weight);
-        histos2d[m_name+"_charge_L0B_vs_gx"]->Fill(hit->getGlobalX(),hit->getCharge(),weight);
-        histos2d[m_name+"_charge_L0B_vs_gy"]->Fill(fabs(hit->getGlobalY()),hit->getCharge(),weight);
+        local2dHisto(m_name+"_gy_L0B_vs_gx")->Fill(hit->getGlobalX(),fabs(hit->getGlobalY()),weight);
+        local2dHisto(m_name+"_charge_L0B_vs_gx")->Fill(hit->getGlobalX(),hit->getCharge(),weight);
+        local2dHisto(m_name+"_charge_L0B_vs_gy")->Fill(fabs(hit->getGlobalY()),hit->getCharge(),weight);
     }
 }
@@ -44,6 +44,36 @@ void HistoManager::Clear() {
 
     histos3d.clear();
 
+    shards1d_.clear();
+    shards2d_.clear();
+    shards3d_.clear();
+    shardHandles1d_.clear();
+    shardHandles2d_.clear();
+    shardBuffers1d_.clear();
+    shardBuffers2d_.clear();
+    buffers1d_.clear();
+    buffers2d_.clear();
+
+    for (auto& native : natives1d_)
+        delete native.second;
+    natives1d_.clear();
+    for (auto& native : natives2d_)
+        delete native.second;
+    natives2d_.clear();
+    nativeShards1d_.clear();
+    nativeShards2d_.clear();
+    nativeHandles1d_.clear();
+    nativeHandles2d_.clear();
+    shardNativeHandles1d_.clear();
+    shardNativeHandles2d_.clear();
+
+    handles1d_.clear();
+    handleNames1d_.clear();
+    handleIndices1d_.clear();
+    handles2d_.clear();
+    handleNames2d_.clear();
+    handleIndices2d_.clear();
+
 }
 
 HistoManager::~HistoManager() {}
@@ -51,42 +81,36 @@ HistoManager::~HistoManager() {}
 void HistoManager::DefineHistos(){
 
     if (debug_ > 0) std::cout << "[HistoManager] DefineHistos" << std::endl;
-    std::string h_name = "";
-    for (auto hist : _h_configs.items()) {
-            h_name = m_name+"_" + hist.key() ;
-            std::size_t found = (hist.key()).find_last_of("_");
-            std::string extension = hist.key().substr(found+1);
-
-            if (extension == "h") {
-                histos1d[h_name] = plot1D(h_name,hist.value().at("xtitle"),
-                        hist.value().at("bins"),
-                        hist.value().at("minX"),
-                        hist.value().at("maxX"));
-
-                std::string ytitle = hist.value().at("ytitle");
-
-                histos1d[h_name]->GetYaxis()->SetTitle(ytitle.c_str());
-
-                if (hist.value().contains("labels")) {
-                    std::vector<std::string> labels = hist.value().at("labels").get<std::vector<std::string> >();
-
-                    if (labels.size() < hist.value().at("bins")) {
-                        std::cout<<"Cannot apply labels to histogram:"<<h_name<<std::endl;
-                    }
-                    else {
-                        for (int i = 1; i<=hist.value().at("bins");++i)
-                            histos1d[h_name]->GetXaxis()->SetBinLabel(i,labels[i-1].c_str());
-                    }//bins
-                }//labels
-            }//1D histo
-
-            else if (extension == "hh") {
-                histos2d[h_name] = plot2D(h_name,
-                        hist.value().at("xtitle"),hist.value().at("binsX"),hist.value().at("minX"),hist.value().at("maxX"),
-                        hist.value().at("ytitle"),hist.value().at("binsY"),hist.value().at("minY"),hist.value().at("maxY"));
-            }
+    if (!templates_)
+        return;
+    for (const HistoTemplate& tmpl : templates_->templates())
+        defineHisto(tmpl, m_name+"_"+tmpl.key_);
+}
 
-    }//loop on config
+void HistoManager::defineHisto(const HistoTemplate& tmpl, const std::string& h_name) {
+
+    if (debug_ > 0) std::cout << "DefineHisto: " << h_name << std::endl;
+
+    if (native_ && tmpl.dim_ == 1 && tmpl.labels_.empty()) {
+        natives1d_[h_name] = new NativeHisto(h_name, tmpl.xtitle_, tmpl.binsX_, tmpl.minX_, tmpl.maxX_, tmpl.ytitle_);
+    }
+    else if (native_ && tmpl.dim_ == 2) {
+        natives2d_[h_name] = new NativeHisto(h_name,
+                tmpl.xtitle_, tmpl.binsX_, tmpl.minX_, tmpl.maxX_,
+                tmpl.ytitle_, tmpl.binsY_, tmpl.minY_, tmpl.maxY_);
+    }
+    else if (tmpl.dim_ == 1) {
+        TH1F* h = plot1D(h_name, tmpl.xtitle_, tmpl.binsX_, tmpl.minX_, tmpl.maxX_);
+        h->GetYaxis()->SetTitle(tmpl.ytitle_.c_str());
+        for (unsigned int i = 0; i < tmpl.labels_.size(); ++i)
+            h->GetXaxis()->SetBinLabel(i+1, tmpl.labels_[i].c_str());
+        histos1d[h_name] = h;
+    }
+    else {
+        histos2d[h_name] = plot2D(h_name,
+                tmpl.xtitle_, tmpl.binsX_, tmpl.minX_, tmpl.maxX_,
+                tmpl.ytitle_, tmpl.binsY_, tmpl.minY_, tmpl.maxY_);
+    }
 }
 
 //This DefineHistos method is only used if you want to make multiple differently named copies of a particular json file histogram configuration. 
@@ -94,54 +118,16 @@ void HistoManager::DefineHistos(){
 //Must also provide a list of names that will be appended to the histo config key
 void HistoManager::DefineHistos(std::vector<std::string> histoCopyNames, std::string makeCopyJsonTag){
     if (debug_ > 0) std::cout << "[HistoManager] DefineHistos" << std::endl;
-    std::string h_name = "";
-    for (auto hist : _h_configs.items()) {
-        bool singleCopy = true;
-        std::cout << "hist copy list size " << histoCopyNames.size() << std::endl;
-        for(int i = 0; i < histoCopyNames.size(); i++){
-            h_name = m_name+"_" + hist.key() ;
-            if (histoCopyNames.size() > 1 && std::string(hist.key()).find(makeCopyJsonTag) != std::string::npos){ 
-                h_name = m_name+"_"+ histoCopyNames.at(i) + "_" + hist.key() ;
-                singleCopy = false;
-            }
-
-            std::cout << "DefineHisto: " << h_name << std::endl;
-            std::size_t found = (hist.key()).find_last_of("_");
-            std::string extension = hist.key().substr(found+1);
-
-            if (extension == "h") {
-                histos1d[h_name] = plot1D(h_name,hist.value().at("xtitle"),
-                        hist.value().at("bins"),
-                        hist.value().at("minX"),
-                        hist.value().at("maxX"));
-
-                std::string ytitle = hist.value().at("ytitle");
-
-                histos1d[h_name]->GetYaxis()->SetTitle(ytitle.c_str());
-
-                if (hist.value().contains("labels")) {
-                    std::vector<std::string> labels = hist.value().at("labels").get<std::vector<std::string> >();
-
-                    if (labels.size() < hist.value().at("bins")) {
-                        std::cout<<"Cannot apply labels to histogram:"<<h_name<<std::endl;
-                    }
-                    else {
-                        for (int i = 1; i<=hist.value().at("bins");++i)
-                            histos1d[h_name]->GetXaxis()->SetBinLabel(i,labels[i-1].c_str());
-                    }//bins
-                }//labels
-            }//1D histo
-
-            else if (extension == "hh") {
-                histos2d[h_name] = plot2D(h_name,
-                        hist.value().at("xtitle"),hist.value().at("binsX"),hist.value().at("minX"),hist.value().at("maxX"),
-                        hist.value().at("ytitle"),hist.value().at("binsY"),hist.value().at("minY"),hist.value().at("maxY"));
-            }
-
-            if(singleCopy)
-                break;
-
+    if (!templates_ || histoCopyNames.empty())
+        return;
+    if (debug_ > 0) std::cout << "hist copy list size " << histoCopyNames.size() << std::endl;
+    for (const HistoTemplate& tmpl : templates_->templates()) {
+        if (histoCopyNames.size() > 1 && tmpl.key_.find(makeCopyJsonTag) != std::string::npos) {
+            for (const std::string& copyName : histoCopyNames)
+                defineHisto(tmpl, m_name+"_"+copyName+"_"+tmpl.key_);
         }
+        else
+            defineHisto(tmpl, m_name+"_"+tmpl.key_);
     }//loop on config
 }
 
@@ -301,49 +287,247 @@ void HistoManager::sumw2() {
 
 }
 
-void HistoManager::Fill2DHisto(const std::string& histoName,float valuex, float valuey, float weight) {
-    if (histos2d[m_name+"_"+histoName])
-        histos2d[m_name+"_"+histoName]->Fill(valuex,valuey,weight);
-    else {
-        printWarnings_++;
-        if (doPrintWarnings_) {
-            if (printWarnings_ < maxWarnings_)
-                std::cout<<"ERROR::Fill2DHisto Histogram not found! "<<m_name+"_"+histoName<<std::endl;
-            else {
-                std::cout<<"Fill2DHisto::Printed max number of warnings " << maxWarnings_ << ". Stop"<<std::endl;
-                doPrintWarnings_ = false;
-            }
-        }
+HistoHandle HistoManager::get1DHandle(const std::string& histoName) {
+    std::string name = m_name+"_"+histoName;
+    HistoHandle handle;
+    std::map<std::string, int>::iterator idx = handleIndices1d_.find(name);
+    if (idx != handleIndices1d_.end()) {
+        handle.index_ = idx->second;
+        return handle;
+    }
+    handle.index_ = handles1d_.size();
+    handles1d_.push_back(get1dHisto(name));
+    for (unsigned int shard = 0; shard < shardHandles1d_.size(); ++shard)
+        shardHandles1d_[shard].push_back(shards1d_.get(shard, name));
+    if (!natives1d_.empty()) {
+        std::map<std::string, NativeHisto*>::iterator native = natives1d_.find(name);
+        nativeHandles1d_.resize(handles1d_.size(), nullptr);
+        nativeHandles1d_[handle.index_] = native != natives1d_.end() ? native->second : nullptr;
+        for (unsigned int shard = 0; shard < shardNativeHandles1d_.size(); ++shard)
+            shardNativeHandles1d_[shard].push_back(nativeShards1d_.get(shard, name));
+    }
+    handleNames1d_.push_back(name);
+    handleIndices1d_[name] = handle.index_;
+    return handle;
+}
+
+HistoHandle HistoManager::get2DHandle(const std::string& histoName) {
+    std::string name = m_name+"_"+histoName;
+    HistoHandle handle;
+    std::map<std::string, int>::iterator idx = handleIndices2d_.find(name);
+    if (idx != handleIndices2d_.end()) {
+        handle.index_ = idx->second;
+        return handle;
+    }
+    handle.index_ = handles2d_.size();
+    handles2d_.push_back(get2dHisto(name));
+    for (unsigned int shard = 0; shard < shardHandles2d_.size(); ++shard)
+        shardHandles2d_[shard].push_back(shards2d_.get(shard, name));
+    if (!natives2d_.empty()) {
+        std::map<std::string, NativeHisto*>::iterator native = natives2d_.find(name);
+        nativeHandles2d_.resize(handles2d_.size(), nullptr);
+        nativeHandles2d_[handle.index_] = native != natives2d_.end() ? native->second : nullptr;
+        for (unsigned int shard = 0; shard < shardNativeHandles2d_.size(); ++shard)
+            shardNativeHandles2d_[shard].push_back(nativeShards2d_.get(shard, name));
     }
+    handleNames2d_.push_back(name);
+    handleIndices2d_[name] = handle.index_;
+    return handle;
 }
 
+void HistoManager::makeShards(int nShards) {
+    shards1d_.make(histos1d, nShards);
+    shards2d_.make(histos2d, nShards);
+    shards3d_.make(histos3d, nShards);
 
-void HistoManager::Fill1DHisto(const std::string& histoName,float value, float weight) {
-    if (histos1d[m_name+"_"+histoName])
-        histos1d[m_name+"_"+histoName]->Fill(value,weight);
-    else {
-        printWarnings_++;
-        if (doPrintWarnings_) {
-            if (printWarnings_ < maxWarnings_)
-                std::cout<<"ERROR::Fill1DHisto Histogram not found! "<<m_name+"_"+histoName<<std::endl;
-            else {
-                std::cout<<"Fill1DHisto::Printed max number of warnings " << maxWarnings_ << ". Stop"<<std::endl;
-                doPrintWarnings_ = false;
-            }
+    shardHandles1d_.assign(shards1d_.size(), std::vector<TH1F*>());
+    for (int shard = 0; shard < shards1d_.size(); ++shard) {
+        for (const std::string& name : handleNames1d_)
+            shardHandles1d_[shard].push_back(shards1d_.get(shard, name));
+    }
+
+    shardHandles2d_.assign(shards2d_.size(), std::vector<TH2F*>());
+    for (int shard = 0; shard < shards2d_.size(); ++shard) {
+        for (const std::string& name : handleNames2d_)
+            shardHandles2d_[shard].push_back(shards2d_.get(shard, name));
+    }
+
+    shardBuffers1d_.assign(shards1d_.size(), std::vector<FillBuffer>());
+    shardBuffers2d_.assign(shards2d_.size(), std::vector<FillBuffer>());
+
+    nativeShards1d_.make(natives1d_, nShards);
+    nativeShards2d_.make(natives2d_, nShards);
+    shardNativeHandles1d_.assign(nativeShards1d_.size(), std::vector<NativeHisto*>());
+    shardNativeHandles2d_.assign(nativeShards2d_.size(), std::vector<NativeHisto*>());
+    if (!natives1d_.empty()) {
+        for (int shard = 0; shard < nativeShards1d_.size(); ++shard) {
+            for (const std::string& name : handleNames1d_)
+                shardNativeHandles1d_[shard].push_back(nativeShards1d_.get(shard, name));
         }
     }
+    if (!natives2d_.empty()) {
+        for (int shard = 0; shard < nativeShards2d_.size(); ++shard) {
+            for (const std::string& name : handleNames2d_)
+                shardNativeHandles2d_[shard].push_back(nativeShards2d_.get(shard, name));
+        }
+    }
+}
+
+void HistoManager::mergeShards() {
+    for (unsigned int shard = 0; shard < shardBuffers1d_.size(); ++shard)
+        flushBuffers(shardHandles1d_[shard], shardBuffers1d_[shard]);
+    for (unsigned int shard = 0; shard < shardBuffers2d_.size(); ++shard)
+        flushBuffers(shardHandles2d_[shard], shardBuffers2d_[shard]);
+    shardBuffers1d_.clear();
+    shardBuffers2d_.clear();
+
+    shards1d_.merge(histos1d);
+    shards2d_.merge(histos2d);
+    shards3d_.merge(histos3d);
+    shardHandles1d_.clear();
+    shardHandles2d_.clear();
+
+    nativeShards1d_.merge(natives1d_);
+    nativeShards2d_.merge(natives2d_);
+    shardNativeHandles1d_.clear();
+    shardNativeHandles2d_.clear();
+}
+
+NativeHisto* HistoManager::localNative1dHisto(const std::string& str) {
+    std::map<std::string, NativeHisto*>* local = nativeShards1d_.local();
+    std::map<std::string, NativeHisto*>& natives = local ? *local : natives1d_;
+    std::map<std::string, NativeHisto*>::iterator it = natives.find(str);
+    return it != natives.end() ? it->second : nullptr;
+}
+
+NativeHisto* HistoManager::localNative2dHisto(const std::string& str) {
+    std::map<std::string, NativeHisto*>* local = nativeShards2d_.local();
+    std::map<std::string, NativeHisto*>& natives = local ? *local : natives2d_;
+    std::map<std::string, NativeHisto*>::iterator it = natives.find(str);
+    return it != natives.end() ? it->second : nullptr;
+}
+
+void HistoManager::makeNativeHistos() {
+    for (auto& native : natives1d_) {
+        histos1d[native.first] = native.second->makeTH1F();
+        delete native.second;
+    }
+    natives1d_.clear();
+    for (auto& native : natives2d_) {
+        histos2d[native.first] = native.second->makeTH2F();
+        delete native.second;
+    }
+    natives2d_.clear();
+    nativeHandles1d_.clear();
+    nativeHandles2d_.clear();
+}
+
+TH1F* HistoManager::local1dHisto(const std::string& str) {
+    std::map<std::string, TH1F*>* local = shards1d_.local();
+    std::map<std::string, TH1F*>& histos = local ? *local : histos1d;
+    it1d it = histos.find(str);
+    return it != histos.end() ? it->second : nullptr;
+}
+
+TH2F* HistoManager::local2dHisto(const std::string& str) {
+    std::map<std::string, TH2F*>* local = shards2d_.local();
+    std::map<std::string, TH2F*>& histos = local ? *local : histos2d;
+    it2d it = histos.find(str);
+    return it != histos.end() ? it->second : nullptr;
+}
+
+TH3F* HistoManager::local3dHisto(const std::string& str) {
+    std::map<std::string, TH3F*>* local = shards3d_.local();
+    std::map<std::string, TH3F*>& histos = local ? *local : histos3d;
+    it3d it = histos.find(str);
+    return it != histos.end() ? it->second : nullptr;
+}
+
+void HistoManager::flushFillBuffers() {
+    flushBuffers(localHandles1d(), localBuffers1d());
+    flushBuffers(localHandles2d(), localBuffers2d());
+}
+
+void HistoManager::flushBuffer(TH1F* histo, FillBuffer& buffer) {
+    histo->FillN(buffer.x_.size(), buffer.x_.data(), buffer.w_.data());
+    buffer.x_.clear();
+    buffer.w_.clear();
+}
+
+void HistoManager::flushBuffer(TH2F* histo, FillBuffer& buffer) {
+    histo->FillN(buffer.x_.size(), buffer.x_.data(), buffer.y_.data(), buffer.w_.data());
+    buffer.x_.clear();
+    buffer.y_.clear();
+    buffer.w_.clear();
+}
+
+void HistoManager::flushBuffers(std::vector<TH1F*>& handles, std::vector<FillBuffer>& buffers) {
+    for (unsigned int i = 0; i < buffers.size(); ++i) {
+        if (!buffers[i].x_.empty())
+            flushBuffer(handles[i], buffers[i]);
+    }
+}
+
+void HistoManager::flushBuffers(std::vector<TH2F*>& handles, std::vector<FillBuffer>& buffers) {
+    for (unsigned int i = 0; i < buffers.size(); ++i) {
+        if (!buffers[i].x_.empty())
+            flushBuffer(handles[i], buffers[i]);
+    }
+}
+
+bool HistoManager::countWarning(const std::string& method) {
+    if (!doPrintWarnings_)
+        return false;
+    if (++printWarnings_ < maxWarnings_)
+        return true;
+    //Only the first thread over the limit prints it
+    if (doPrintWarnings_.exchange(false))
+        std::cout<<method<<"::Printed max number of warnings " << maxWarnings_ << ". Stop"<<std::endl;
+    return false;
+}
+
+void HistoManager::missingHisto(const std::string& method, HistoHandle handle, std::size_t nHandles, 
+        const std::vector<std::string>& names) {
+    if (!countWarning(method))
+        return;
+    if ((unsigned int)handle.index_ < nHandles)
+        std::cout<<"ERROR::"<<method<<" Histogram not found! "<<names[handle.index_]<<std::endl;
+    else
+        std::cout<<"ERROR::"<<method<<" Invalid histogram handle "<<handle.index_<<std::endl;
+}
+
+void HistoManager::Fill2DHisto(const std::string& histoName,float valuex, float valuey, float weight) {
+    TH2F* histo = local2dHisto(m_name+"_"+histoName);
+    NativeHisto* native = histo || natives2d_.empty() ? nullptr : localNative2dHisto(m_name+"_"+histoName);
+    if (histo)
+        histo->Fill(valuex,valuey,weight);
+    else if (native)
+        native->Fill(valuex,valuey,weight);
+    else if (countWarning("Fill2DHisto"))
+        std::cout<<"ERROR::Fill2DHisto Histogram not found! "<<m_name+"_"+histoName<<std::endl;
+}
+
+
+void HistoManager::Fill1DHisto(const std::string& histoName,float value, float weight) {
+    TH1F* histo = local1dHisto(m_name+"_"+histoName);
+    NativeHisto* native = histo || natives1d_.empty() ? nullptr : localNative1dHisto(m_name+"_"+histoName);
+    if (histo)
+        histo->Fill(value,weight);
+    else if (native)
+        native->Fill(value,weight);
+    else if (countWarning("Fill1DHisto"))
+        std::cout<<"ERROR::Fill1DHisto Histogram not found! "<<m_name+"_"+histoName<<std::endl;
 }
 
 
 void HistoManager::loadHistoConfig(const std::string histoConfigFile) {
 
-    std::ifstream i_file(histoConfigFile);
-    i_file >> _h_configs;
+    templates_ = HistoTemplates::get(histoConfigFile);
+    _h_configs = templates_->config();
     if (debug_) {
         for (auto& el : _h_configs.items()) 
             std::cout << el.key() << " : " << el.value() << "\n";
     }
-    i_file.close();
 
 }
 
@@ -352,6 +536,10 @@ void HistoManager::loadHistoConfig(const std::string histoConfigFile) {
 
 void HistoManager::saveHistos(TFile* outF,std::string folder) {
 
+    mergeShards();
+    flushBuffers(handles1d_, buffers1d_);
+    flushBuffers(handles2d_, buffers2d_);
+
     if (outF) outF->cd();
     TDirectory* dir{nullptr};
 
@@ -360,6 +548,8 @@ void HistoManager::saveHistos(TFile* outF,std::string folder) {
         dir->cd();
     }
 
+    makeNativeHistos();
+
     for (it3d it = histos3d.begin(); it!=histos3d.end(); ++it) {
         if (!it->second){
             std::cout<<it->first<<" Null ptr in saving.."<<std::endl;
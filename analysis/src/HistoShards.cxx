@@ -0,0 +1,13 @@
+#include "HistoShards.h"
+
+namespace {
+    thread_local int currentShard{-1};
+}
+
+int HistoShard::current() {
+    return currentShard;
+}
+
+void HistoShard::setCurrent(int shard) {
+    currentShard = shard;
+}
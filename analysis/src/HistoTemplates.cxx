@@ -0,0 +1,75 @@
+#include "HistoTemplates.h"
+#include <fstream>
+#include <iostream>
+
+std::shared_ptr<HistoTemplates> HistoTemplates::get(const std::string& configFile) {
+    static std::mutex cacheMutex;
+    static std::map<std::string, std::shared_ptr<HistoTemplates> > cache;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    std::map<std::string, std::shared_ptr<HistoTemplates> >::iterator it = cache.find(configFile);
+    if (it != cache.end())
+        return it->second;
+    std::shared_ptr<HistoTemplates> templates(new HistoTemplates(configFile));
+    cache[configFile] = templates;
+    return templates;
+}
+
+HistoTemplates::HistoTemplates(const std::string& configFile) : configFile_(configFile) {
+    std::ifstream i_file(configFile);
+    i_file >> config_;
+    i_file.close();
+}
+
+const std::vector<HistoTemplate>& HistoTemplates::templates() {
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (built_)
+        return templates_;
+
+    std::vector<HistoTemplate> templates;
+    for (auto hist : config_.items()) {
+
+        //Get the extension of the name to decide the histogram to create
+        std::size_t found = (hist.key()).find_last_of("_");
+        std::string extension = hist.key().substr(found+1);
+
+        HistoTemplate tmpl;
+        tmpl.key_ = hist.key();
+        if (extension == "h") {
+            tmpl.dim_   = 1;
+            tmpl.xtitle_ = hist.value().at("xtitle").get<std::string>();
+            tmpl.binsX_  = hist.value().at("bins").get<int>();
+            tmpl.minX_   = hist.value().at("minX").get<float>();
+            tmpl.maxX_   = hist.value().at("maxX").get<float>();
+            tmpl.ytitle_ = hist.value().at("ytitle").get<std::string>();
+
+            if (hist.value().contains("labels")) {
+                std::vector<std::string> labels = hist.value().at("labels").get<std::vector<std::string> >();
+                if ((int)labels.size() < tmpl.binsX_)
+                    std::cout<<"Cannot apply labels to histogram:"<<tmpl.key_<<" of "<<configFile_<<std::endl;
+                else
+                    tmpl.labels_.assign(labels.begin(), labels.begin() + tmpl.binsX_);
+            }
+        }
+        else if (extension == "hh") {
+            tmpl.dim_    = 2;
+            tmpl.xtitle_ = hist.value().at("xtitle").get<std::string>();
+            tmpl.binsX_  = hist.value().at("binsX").get<int>();
+            tmpl.minX_   = hist.value().at("minX").get<float>();
+            tmpl.maxX_   = hist.value().at("maxX").get<float>();
+            tmpl.ytitle_ = hist.value().at("ytitle").get<std::string>();
+            tmpl.binsY_  = hist.value().at("binsY").get<int>();
+            tmpl.minY_   = hist.value().at("minY").get<float>();
+            tmpl.maxY_   = hist.value().at("maxY").get<float>();
+        }
+        else
+            continue;
+
+        templates.push_back(tmpl);
+    }
+
+    templates_.swap(templates);
+    built_ = true;
+    return templates_;
+}
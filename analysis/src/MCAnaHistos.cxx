@@ -35,7 +35,30 @@ void MCAnaHistos::Define2DHistos() {
     }
 }
 
+void MCAnaHistos::Clear() {
+    HistoManager::Clear();
+    handlesResolved_ = false;
+}
+
+void MCAnaHistos::makeShards(int nShards) {
+    getHandles();
+    HistoManager::makeShards(nShards);
+}
+
+const MCAnaHistos::Handles& MCAnaHistos::getHandles() {
+    if (handlesResolved_)
+        return handles_;
+    handles_.partsEnergy    = get1DHandle("MCpartsEnergy_h");
+    handles_.partsEnergyLow = get1DHandle("MCpartsEnergyLow_h");
+    handles_.trkrHitEdep    = get1DHandle("mcTrkrHitEdep_h");
+    handles_.trkrHitPdgId   = get1DHandle("mcTrkrHitPdgId_h");
+    handles_.ecalHitEnergy  = get1DHandle("mcEcalHitEnergy_h");
+    handlesResolved_ = true;
+    return handles_;
+}
+
 void MCAnaHistos::FillMCParticles(std::vector<MCParticle*> *mcParts, std::string analysis, float weight ) {
+    const Handles& h = getHandles();
     int nParts = mcParts->size();
     Fill1DHisto("numMCparts_h", (float)nParts, weight);
     int nMuons = 0;
@@ -139,8 +162,8 @@ void MCAnaHistos::FillMCParticles(std::vector<MCParticle*> *mcParts, std::string
             Fill1DHisto("truthRadPosPz_h",part4P.Pz(),weight);
         }
 
-        Fill1DHisto("MCpartsEnergy_h", energy, weight);
-        Fill1DHisto("MCpartsEnergyLow_h", energy*1000.0, weight);// Scaled to MeV
+        BufferFill1DHisto(h.partsEnergy, energy, weight);
+        BufferFill1DHisto(h.partsEnergyLow, energy*1000.0, weight);// Scaled to MeV
     }
 
     //TLorentzVector res = ele + pos;
@@ -152,23 +175,25 @@ void MCAnaHistos::FillMCParticles(std::vector<MCParticle*> *mcParts, std::string
 }
 
 void MCAnaHistos::FillMCTrackerHits(std::vector<MCTrackerHit*> *mcTrkrHits, float weight ) {
+    const Handles& h = getHandles();
     int nHits = mcTrkrHits->size();
     Fill1DHisto("numMCTrkrHit_h", nHits, weight);
     for (int i=0; i < nHits; i++)
     {
         MCTrackerHit *hit = mcTrkrHits->at(i);
         int pdg = hit->getPDG();
-        Fill1DHisto("mcTrkrHitEdep_h", hit->getEdep()*1000.0, weight); // Scaled to MeV
-        Fill1DHisto("mcTrkrHitPdgId_h", (float)hit->getPDG(), weight);
+        BufferFill1DHisto(h.trkrHitEdep, hit->getEdep()*1000.0, weight); // Scaled to MeV
+        BufferFill1DHisto(h.trkrHitPdgId, (float)hit->getPDG(), weight);
     }
 }
 
 void MCAnaHistos::FillMCEcalHits(std::vector<MCEcalHit*> *mcEcalHits, float weight ) {
+    const Handles& h = getHandles();
     int nHits = mcEcalHits->size();
     Fill1DHisto("numMCEcalHit_h", nHits, weight);
     for (int i=0; i < nHits; i++)
     {
         MCEcalHit *hit = mcEcalHits->at(i);
-        Fill1DHisto("mcEcalHitEnergy_h", hit->getEnergy()*1000.0, weight); // Scaled to MeV
+        BufferFill1DHisto(h.ecalHitEnergy, hit->getEnergy()*1000.0, weight); // Scaled to MeV
     }
 }
@@ -0,0 +1,85 @@
+#include "NativeHisto.h"
+#include <algorithm>
+
+NativeHisto::NativeHisto(const std::string& name, const std::string& xtitle, int nbinsX, float xmin, float xmax,
+        const std::string& ytitle) {
+    name_ = name;
+    dim_ = 1;
+    x_.nbins_ = nbinsX;
+    x_.min_ = xmin;
+    x_.max_ = xmax;
+    x_.title_ = xtitle;
+    y_.title_ = ytitle;
+    sumw_.assign(nbinsX+2, 0.);
+    sumw2_.assign(nbinsX+2, 0.);
+}
+
+NativeHisto::NativeHisto(const std::string& name,
+        const std::string& xtitle, int nbinsX, float xmin, float xmax,
+        const std::string& ytitle, int nbinsY, float ymin, float ymax) {
+    name_ = name;
+    dim_ = 2;
+    x_.nbins_ = nbinsX;
+    x_.min_ = xmin;
+    x_.max_ = xmax;
+    x_.title_ = xtitle;
+    y_.nbins_ = nbinsY;
+    y_.min_ = ymin;
+    y_.max_ = ymax;
+    y_.title_ = ytitle;
+    sumw_.assign((nbinsX+2)*(nbinsY+2), 0.);
+    sumw2_.assign((nbinsX+2)*(nbinsY+2), 0.);
+}
+
+void NativeHisto::Reset() {
+    std::fill(sumw_.begin(), sumw_.end(), 0.);
+    std::fill(sumw2_.begin(), sumw2_.end(), 0.);
+    entries_ = 0.;
+    std::fill(stats_, stats_+7, 0.);
+    std::fill(overflowStats_, overflowStats_+7, 0.);
+}
+
+void NativeHisto::Add(const NativeHisto* other) {
+    //Summed in double and stored as float, as TH1F::Add does
+    for (unsigned int bin = 0; bin < sumw_.size(); ++bin) {
+        sumw_[bin] = double(sumw_[bin]) + double(other->sumw_[bin]);
+        sumw2_[bin] += other->sumw2_[bin];
+    }
+    entries_ += other->entries_;
+    for (int i = 0; i < 7; ++i) {
+        stats_[i] += other->stats_[i];
+        overflowStats_[i] += other->overflowStats_[i];
+    }
+}
+
+TH1F* NativeHisto::makeTH1F() const {
+    TH1F* h = new TH1F(name_.c_str(), name_.c_str(), x_.nbins_, x_.min_, x_.max_);
+    h->GetXaxis()->SetTitle(x_.title_.c_str());
+    h->GetYaxis()->SetTitle(y_.title_.c_str());
+    h->Sumw2();
+    copyTo(h, h->GetArray());
+    return h;
+}
+
+TH2F* NativeHisto::makeTH2F() const {
+    TH2F* h = new TH2F(name_.c_str(), name_.c_str(),
+            x_.nbins_, x_.min_, x_.max_,
+            y_.nbins_, y_.min_, y_.max_);
+    h->GetXaxis()->SetTitle(x_.title_.c_str());
+    h->GetYaxis()->SetTitle(y_.title_.c_str());
+    h->Sumw2();
+    copyTo(h, h->GetArray());
+    return h;
+}
+
+void NativeHisto::copyTo(TH1* histo, float* contents) const {
+    std::copy(sumw_.begin(), sumw_.end(), contents);
+    std::copy(sumw2_.begin(), sumw2_.end(), histo->GetSumw2()->GetArray());
+
+    bool overflows = histo->GetStatOverflowsBehaviour();
+    double stats[7];
+    for (int i = 0; i < 7; ++i)
+        stats[i] = stats_[i] + (overflows ? overflowStats_[i] : 0.);
+    histo->PutStats(stats);
+    histo->SetEntries(entries_);
+}
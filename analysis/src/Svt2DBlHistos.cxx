@@ -26,14 +26,40 @@ void Svt2DBlHistos::DefineHistos(){
 
 }
 
+void Svt2DBlHistos::Clear() {
+    HistoManager::Clear();
+    hybridHandlesResolved_ = false;
+}
+
+void Svt2DBlHistos::makeShards(int nShards) {
+    resolveHybridHandles();
+    HistoManager::makeShards(nShards);
+}
+
+void Svt2DBlHistos::resolveHybridHandles() {
+    if (hybridHandlesResolved_)
+        return;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 1; j < 15; j++) {
+            if (j<9 && i>1)
+                continue;
+            std::string swTag = mmapper_->getStringFromSw("ly"+std::to_string(j)+"_m"+std::to_string(i));
+            hybridHandles_[i][j].hitN = get1DHandle(swTag+"_SvtHybridsHitN_h");
+            hybridHandles_[i][j].adc0 = get2DHandle(swTag+"_SvtHybrids0_hh");
+            hybridHandles_[i][j].adc3 = get2DHandle(swTag+"_SvtHybrids3_hh");
+        }
+    }
+    hybridHandlesResolved_ = true;
+}
+
 void Svt2DBlHistos::FillHistograms(std::vector<RawSvtHit*> *rawSvtHits_,float weight) {
 
     int nhits = rawSvtHits_->size();
-    std::vector<std::string> hybridStrings={};
-    std::string histokey;
     if(Event_number%10000 == 0) std::cout << "Event: " << Event_number 
         << " Number of RawSvtHits: " << nhits << std::endl;
 
+    resolveHybridHandles();
+
     //Following Block counts the total number of hits each hybrid records per event
     int svtHybMulti[4][15] = {0};
     for (int i = 0; i < nhits; i++)
@@ -50,9 +76,7 @@ void Svt2DBlHistos::FillHistograms(std::vector<RawSvtHit*> *rawSvtHits_,float we
         {
             if (!(j<9 && i>1))
             {   
-                std::string swTag = mmapper_->getStringFromSw("ly"+std::to_string(j)+"_m"+std::to_string(i));
-                hybridStrings.push_back(swTag);
-                Fill1DHisto(swTag+ "_SvtHybridsHitN_h", svtHybMulti[i][j],weight);
+                Fill1DHisto(hybridHandles_[i][j].hitN, svtHybMulti[i][j],weight);
             }
         }
     }
@@ -60,27 +84,21 @@ void Svt2DBlHistos::FillHistograms(std::vector<RawSvtHit*> *rawSvtHits_,float we
     Fill1DHisto("SvtHitMulti_h", nhits,weight);
     //End of counting block
 
-    //Populates histograms for each hybrid
+    //Populates histograms for each hybrid, buffered since they are filled once per hit
+    //Manually select which baselines (0 - 6) are included. THIS MUST MATCH THE JSON FILE!
     for (int i = 0; i < nhits; i++)
     {
         RawSvtHit* rawSvtHit = rawSvtHits_->at(i);
-        auto mod = std::to_string(rawSvtHit->getModule());
-        auto lay = std::to_string(rawSvtHit->getLayer());
-        std::string swTag= mmapper_->getStringFromSw("ly"+lay+"_m"+mod);
-        
-        //Manually select which baselines (0 - 6) are included. THIS MUST MATCH THE JSON FILE!
-        int ss = 0;
-        histokey = swTag + "_SvtHybrids"+std::to_string(ss)+"_hh";
-                    Fill2DHisto(histokey, 
+        const HybridHandles& h = hybridHandles_[rawSvtHit->getModule()][rawSvtHit->getLayer()];
+
+        BufferFill2DHisto(h.adc0, 
                 (float)rawSvtHit->getStrip(),
-                (float)rawSvtHit->getADCs()[ss], 
+                (float)rawSvtHit->getADCs()[0], 
                 weight);
 
-        ss = 3;
-        histokey = swTag + "_SvtHybrids"+std::to_string(ss)+"_hh";
-                    Fill2DHisto(histokey, 
+        BufferFill2DHisto(h.adc3, 
                 (float)rawSvtHit->getStrip(),
-                (float)rawSvtHit->getADCs()[ss], 
+                (float)rawSvtHit->getADCs()[3], 
                 weight);
         
     }
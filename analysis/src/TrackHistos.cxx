@@ -5,6 +5,152 @@
 
 void TrackHistos::BuildAxes(){}
 
+void TrackHistos::Clear() {
+    HistoManager::Clear();
+    trackHandles_.clear();
+    residualHandles_.clear();
+    vertexHandlesResolved_ = false;
+}
+
+void TrackHistos::makeShards(int nShards) {
+    for (const std::string& trkname : {"", "ele_", "pos_", "topEle_", "botEle_", "topPos_", "botPos_"})
+        getTrackHandles(trkname);
+    getVertexHandles();
+    for (int ly = 0; ly <= 14; ++ly)
+        getResidualHandles(ly);
+    HistoManager::makeShards(nShards);
+}
+
+const TrackHistos::TrackHandles& TrackHistos::getTrackHandles(const std::string& trkname) {
+
+    std::map<std::string, TrackHandles>::iterator it = trackHandles_.find(trkname);
+    if (it != trackHandles_.end())
+        return it->second;
+
+    TrackHandles& h = trackHandles_[trkname];
+    h.d0          = get1DHandle(trkname+"d0_h");
+    h.phi         = get1DHandle(trkname+"Phi_h");
+    h.omega       = get1DHandle(trkname+"Omega_h");
+    h.pT          = get1DHandle(trkname+"pT_h");
+    h.p           = get1DHandle(trkname+"p_h");
+    h.invpT       = get1DHandle(trkname+"invpT_h");
+    h.tanLambda   = get1DHandle(trkname+"TanLambda_h");
+    h.z0          = get1DHandle(trkname+"Z0_h");
+    h.time        = get1DHandle(trkname+"time_h");
+    h.chi2        = get1DHandle(trkname+"chi2_h");
+    h.chi2ndf     = get1DHandle(trkname+"chi2ndf_h");
+    h.nShared     = get1DHandle(trkname+"nShared_h");
+    h.nHits2d     = get1DHandle(trkname+"nHits_2d_h");
+    h.sharingHits = get1DHandle(trkname+"sharingHits_h");
+    h.strategy    = get1DHandle(trkname+"strategy_h");
+    h.type        = get1DHandle(trkname+"type_h");
+
+    h.tanlambda_vs_phi0 = get2DHandle(trkname+"tanlambda_vs_phi0_hh");
+    h.d0_vs_p           = get2DHandle(trkname+"d0_vs_p_hh");
+    h.d0_vs_phi0        = get2DHandle(trkname+"d0_vs_phi0_hh");
+    h.d0_vs_tanlambda   = get2DHandle(trkname+"d0_vs_tanlambda_hh");
+    h.z0_vs_p           = get2DHandle(trkname+"z0_vs_p_hh");
+    h.phi0_vs_p         = get2DHandle(trkname+"phi0_vs_p_hh");
+    h.z0_vs_phi0        = get2DHandle(trkname+"z0_vs_phi0_hh");
+    h.z0_vs_tanlambda   = get2DHandle(trkname+"z0_vs_tanlambda_hh");
+
+    h.d0_res            = get1DHandle(trkname+"d0_truth_res_h");
+    h.phi_res           = get1DHandle(trkname+"Phi_truth_res_h");
+    h.omega_res         = get1DHandle(trkname+"Omega_truth_res_h");
+    h.tanLambda_res     = get1DHandle(trkname+"TanLambda_truth_res_h");
+    h.z0_res            = get1DHandle(trkname+"Z0_truth_res_h");
+    h.p_res             = get1DHandle(trkname+"p_truth_res_h");
+    h.invpT_res         = get1DHandle(trkname+"invpT_truth_res_h");
+    h.invpT_res_percent = get1DHandle(trkname+"invpT_truth_res_percent_h");
+    h.px_res            = get1DHandle(trkname+"px_truth_res_h");
+    h.py_res            = get1DHandle(trkname+"py_truth_res_h");
+    h.pz_res            = get1DHandle(trkname+"pz_truth_res_h");
+    h.d0_pull           = get1DHandle(trkname+"d0_truth_pull_h");
+    h.phi_pull          = get1DHandle(trkname+"Phi_truth_pull_h");
+    h.omega_pull        = get1DHandle(trkname+"Omega_truth_pull_h");
+    h.tanLambda_pull    = get1DHandle(trkname+"TanLambda_truth_pull_h");
+    h.z0_pull           = get1DHandle(trkname+"Z0_truth_pull_h");
+    return h;
+}
+
+const TrackHistos::VertexHandles& TrackHistos::getVertexHandles() {
+
+    if (vertexHandlesResolved_)
+        return vertexHandles_;
+
+    VertexHandles& h = vertexHandles_;
+    h.chi2      = get1DHandle("vtx_chi2_h");
+    h.XY        = get2DHandle("vtx_XY_hh");
+    h.X         = get1DHandle("vtx_X_h");
+    h.Y         = get1DHandle("vtx_Y_h");
+    h.Z         = get1DHandle("vtx_Z_h");
+    h.XY_svt    = get2DHandle("vtx_XY_svt_hh");
+    h.X_svt     = get1DHandle("vtx_X_svt_h");
+    h.Y_svt     = get1DHandle("vtx_Y_svt_h");
+    h.Z_svt     = get1DHandle("vtx_Z_svt_h");
+    h.sigma_X   = get1DHandle("vtx_sigma_X_h");
+    h.sigma_Y   = get1DHandle("vtx_sigma_Y_h");
+    h.sigma_Z   = get1DHandle("vtx_sigma_Z_h");
+    h.InvM      = get1DHandle("vtx_InvM_h");
+    h.InvMErr   = get1DHandle("vtx_InvMErr_Z_h");
+    h.px        = get1DHandle("vtx_px_h");
+    h.py        = get1DHandle("vtx_py_h");
+    h.pz        = get1DHandle("vtx_pz_h");
+    h.p         = get1DHandle("vtx_p_h");
+
+    h.ele_p     = get1DHandle("ele_p_h");
+    h.pos_p     = get1DHandle("pos_p_h");
+    h.ele_clusE = get1DHandle("ele_clusE_h");
+    h.pos_clusE = get1DHandle("pos_clusE_h");
+    h.ele_EoP   = get1DHandle("ele_EoP_h");
+    h.pos_EoP   = get1DHandle("pos_EoP_h");
+    h.EoP       = get2DHandle("EoP_hh");
+    h.Pmiss     = get1DHandle("Pmiss_h");
+    h.Esum      = get1DHandle("Esum_h");
+    h.EsumClus  = get1DHandle("EsumClus_h");
+    h.EClus     = get2DHandle("EClus_hh");
+    h.InvM_eleP = get2DHandle("InvM_eleP_hh");
+    h.InvM_posP = get2DHandle("InvM_posP_hh");
+    h.Psum      = get1DHandle("Psum_h");
+    h.PtAsym    = get1DHandle("PtAsym_h");
+    h.thetax_v0   = get1DHandle("thetax_v0_h");
+    h.thetax_pos  = get1DHandle("thetax_pos_h");
+    h.thetay_pos  = get1DHandle("thetay_pos_h");
+    h.thetay_miss = get1DHandle("thetay_miss_h");
+    h.thetay_diff = get1DHandle("thetay_diff_h");
+
+    h.InvM_z      = get2DHandle("vtx_InvM_vtx_z_hh");
+    h.InvM_svt_z  = get2DHandle("vtx_InvM_vtx_svt_z_hh");
+    h.p_svt_z     = get2DHandle("vtx_p_svt_z_hh");
+    h.p_svt_x     = get2DHandle("vtx_p_svt_x_hh");
+    h.p_svt_y     = get2DHandle("vtx_p_svt_y_hh");
+    h.svt_y_svt_z = get2DHandle("vtx_svt_y_svt_z_hh");
+    h.p_sigmaZ    = get2DHandle("vtx_p_sigmaZ_hh");
+    h.p_sigmaX    = get2DHandle("vtx_p_sigmaX_hh");
+    h.p_sigmaY    = get2DHandle("vtx_p_sigmaY_hh");
+
+    vertexHandlesResolved_ = true;
+    return h;
+}
+
+const TrackHistos::ResidualHandles& TrackHistos::getResidualHandles(int ly) {
+
+    std::map<int, ResidualHandles>::iterator it = residualHandles_.find(ly);
+    if (it != residualHandles_.end())
+        return it->second;
+
+    std::string lyr = std::to_string(ly);
+    ResidualHandles& h = residualHandles_[ly];
+    h.res         = get1DHandle("u_res_ly_"+lyr+"_h");
+    h.res_vsp     = get2DHandle("u_res_ly_"+lyr+"_vsp_hh");
+    h.res_vsy     = get2DHandle("u_res_ly_"+lyr+"_vsy_hh");
+    h.res_top     = get1DHandle("u_res_ly_"+lyr+"_top_h");
+    h.res_top_vsp = get2DHandle("u_res_ly_"+lyr+"_top_vsp_hh");
+    h.res_bot     = get1DHandle("u_res_ly_"+lyr+"_bot_h");
+    h.res_bot_vsp = get2DHandle("u_res_ly_"+lyr+"_bot_vsp_hh");
+    return h;
+}
+
 void TrackHistos::DefineTrkHitHistos(){
 
     std::vector<std::string> trkTypes;
@@ -116,14 +262,16 @@ void TrackHistos::Fill1DVertex(Vertex* vtx,
     //p_pos.SetPxPyPzE(pos->getMomentum()[0], pos->getMomentum()[1],pos->getMomentum()[2],pos->getEnergy());
     p_pos.SetPxPyPzE(pos_trk->getMomentum()[0],pos_trk->getMomentum()[1],pos_trk->getMomentum()[2],pos->getEnergy());
 
+    const VertexHandles& h = getVertexHandles();
+
     //Fill ele and pos information
-    Fill1DHisto("ele_p_h",p_ele.P(),weight);
-    Fill1DHisto("pos_p_h",p_pos.P(),weight);
-    Fill1DHisto("ele_clusE_h",eleClus.getEnergy(),weight);
-    Fill1DHisto("pos_clusE_h",posClus.getEnergy(),weight);
-    Fill1DHisto("ele_EoP_h",eleClus.getEnergy()/p_ele.P(),weight);
-    Fill1DHisto("pos_EoP_h",posClus.getEnergy()/p_pos.P(),weight);
-    Fill2DHisto("EoP_hh", eleClus.getEnergy()/p_ele.P(), posClus.getEnergy()/p_pos.P(),weight);
+    Fill1DHisto(h.ele_p,p_ele.P(),weight);
+    Fill1DHisto(h.pos_p,p_pos.P(),weight);
+    Fill1DHisto(h.ele_clusE,eleClus.getEnergy(),weight);
+    Fill1DHisto(h.pos_clusE,posClus.getEnergy(),weight);
+    Fill1DHisto(h.ele_EoP,eleClus.getEnergy()/p_ele.P(),weight);
+    Fill1DHisto(h.pos_EoP,posClus.getEnergy()/p_pos.P(),weight);
+    Fill2DHisto(h.EoP, eleClus.getEnergy()/p_ele.P(), posClus.getEnergy()/p_pos.P(),weight);
 
 
     //Compute some extra variables 
@@ -160,19 +308,19 @@ void TrackHistos::Fill1DVertex(Vertex* vtx,
     //Fill event information
 
     //Esum
-    Fill1DHisto("Pmiss_h", p_miss.P(),weight);
-    Fill1DHisto("Esum_h",ele->getEnergy() + pos->getEnergy(),weight);
-    Fill1DHisto("EsumClus_h",eleClus.getEnergy() + posClus.getEnergy(),weight);
-    Fill2DHisto("EClus_hh", eleClus.getEnergy() , posClus.getEnergy(),weight);
-    Fill2DHisto("InvM_eleP_hh", p_ele.P(), vtx->getInvMass(),weight);
-    Fill2DHisto("InvM_posP_hh", p_pos.P(), vtx->getInvMass(), weight);
-    Fill1DHisto("Psum_h",p_ele.P() + p_pos.P(),weight);
-    Fill1DHisto("PtAsym_h",pt_asym_val,weight);
-    Fill1DHisto("thetax_v0_h",thetax_v0_val,weight);
-    Fill1DHisto("thetax_pos_h",thetax_pos_val,weight);
-    Fill1DHisto("thetay_pos_h",thetay_pos_val,weight);
-    Fill1DHisto("thetay_miss_h",thetay_miss_val,weight);
-    Fill1DHisto("thetay_diff_h",thetay_diff_val,weight);
+    Fill1DHisto(h.Pmiss, p_miss.P(),weight);
+    Fill1DHisto(h.Esum,ele->getEnergy() + pos->getEnergy(),weight);
+    Fill1DHisto(h.EsumClus,eleClus.getEnergy() + posClus.getEnergy(),weight);
+    Fill2DHisto(h.EClus, eleClus.getEnergy() , posClus.getEnergy(),weight);
+    Fill2DHisto(h.InvM_eleP, p_ele.P(), vtx->getInvMass(),weight);
+    Fill2DHisto(h.InvM_posP, p_pos.P(), vtx->getInvMass(), weight);
+    Fill1DHisto(h.Psum,p_ele.P() + p_pos.P(),weight);
+    Fill1DHisto(h.PtAsym,pt_asym_val,weight);
+    Fill1DHisto(h.thetax_v0,thetax_v0_val,weight);
+    Fill1DHisto(h.thetax_pos,thetax_pos_val,weight);
+    Fill1DHisto(h.thetay_pos,thetay_pos_val,weight);
+    Fill1DHisto(h.thetay_miss,thetay_miss_val,weight);
+    Fill1DHisto(h.thetay_diff,thetay_diff_val,weight);
 }
 
 
@@ -181,17 +329,18 @@ void TrackHistos::Fill2DTrack(Track* track, float weight, const std::string& trk
 
     if (track) {
 
+        const TrackHandles& h = getTrackHandles(trkname);
         double d0 = track->getD0();
         double z0 = track->getZ0();
-        Fill2DHisto(trkname+"tanlambda_vs_phi0_hh",track->getPhi(),track->getTanLambda(), weight);
-        Fill2DHisto(trkname+"d0_vs_p_hh",track->getP(),d0,weight);
-        Fill2DHisto(trkname+"d0_vs_phi0_hh",track->getPhi(),d0,weight);
-        Fill2DHisto(trkname+"d0_vs_tanlambda_hh",track->getTanLambda(),d0,weight);
+        Fill2DHisto(h.tanlambda_vs_phi0,track->getPhi(),track->getTanLambda(), weight);
+        Fill2DHisto(h.d0_vs_p,track->getP(),d0,weight);
+        Fill2DHisto(h.d0_vs_phi0,track->getPhi(),d0,weight);
+        Fill2DHisto(h.d0_vs_tanlambda,track->getTanLambda(),d0,weight);
 
-        Fill2DHisto(trkname+"z0_vs_p_hh",track->getP(),z0,weight);
-        Fill2DHisto(trkname+"phi0_vs_p_hh",track->getP(),track->getPhi(),weight);
-        Fill2DHisto(trkname+"z0_vs_phi0_hh",track->getPhi(),z0,weight);
-        Fill2DHisto(trkname+"z0_vs_tanlambda_hh",track->getTanLambda(),z0,weight);
+        Fill2DHisto(h.z0_vs_p,track->getP(),z0,weight);
+        Fill2DHisto(h.phi0_vs_p,track->getP(),track->getPhi(),weight);
+        Fill2DHisto(h.z0_vs_phi0,track->getPhi(),z0,weight);
+        Fill2DHisto(h.z0_vs_tanlambda,track->getTanLambda(),z0,weight);
 
     }
 }
@@ -205,60 +354,64 @@ void TrackHistos::Fill1DTrack(Track* track, float weight, const std::string& trk
     if (!track->isKalmanTrack())
         n_hits_2d*=2;
 
-    Fill1DHisto(trkname+"d0_h"       ,track->getD0()          ,weight);
-    Fill1DHisto(trkname+"Phi_h"      ,track->getPhi()         ,weight);
-    Fill1DHisto(trkname+"Omega_h"    ,track->getOmega()       ,weight);
-    Fill1DHisto(trkname+"pT_h"       ,-1*charge*track->getPt(),weight);
-    Fill1DHisto(trkname+"p_h"        ,track->getP()           ,weight);
-    Fill1DHisto(trkname+"invpT_h"    ,-1*charge/track->getPt(),weight);
-    Fill1DHisto(trkname+"TanLambda_h",track->getTanLambda()   ,weight);
-    Fill1DHisto(trkname+"Z0_h"       ,track->getZ0()          ,weight);
-    Fill1DHisto(trkname+"time_h"     ,track->getTrackTime()   ,weight);
-    Fill1DHisto(trkname+"chi2_h"     ,track->getChi2()        ,weight);
-    Fill1DHisto(trkname+"chi2ndf_h"  ,track->getChi2Ndf()     ,weight);
-    Fill1DHisto(trkname+"nShared_h"  ,track->getNShared()     ,weight);
-    Fill1DHisto(trkname+"nHits_2d_h" ,n_hits_2d               ,weight);
+    const TrackHandles& h = getTrackHandles(trkname);
+
+    Fill1DHisto(h.d0       ,track->getD0()          ,weight);
+    Fill1DHisto(h.phi      ,track->getPhi()         ,weight);
+    Fill1DHisto(h.omega    ,track->getOmega()       ,weight);
+    Fill1DHisto(h.pT       ,-1*charge*track->getPt(),weight);
+    Fill1DHisto(h.p        ,track->getP()           ,weight);
+    Fill1DHisto(h.invpT    ,-1*charge/track->getPt(),weight);
+    Fill1DHisto(h.tanLambda,track->getTanLambda()   ,weight);
+    Fill1DHisto(h.z0       ,track->getZ0()          ,weight);
+    Fill1DHisto(h.time     ,track->getTrackTime()   ,weight);
+    Fill1DHisto(h.chi2     ,track->getChi2()        ,weight);
+    Fill1DHisto(h.chi2ndf  ,track->getChi2Ndf()     ,weight);
+    Fill1DHisto(h.nShared  ,track->getNShared()     ,weight);
+    Fill1DHisto(h.nHits2d  ,n_hits_2d               ,weight);
 
     //All Tracks
-    Fill1DHisto(trkname+"sharingHits_h",0,weight);
+    Fill1DHisto(h.sharingHits,0,weight);
     if (track->getNShared() == 0)
-        Fill1DHisto(trkname+"sharingHits_h",1.,weight);
+        Fill1DHisto(h.sharingHits,1.,weight);
     else {
         //track has shared hits
         if (track->getSharedLy0())
-            Fill1DHisto(trkname+"sharingHits_h",2.,weight);
+            Fill1DHisto(h.sharingHits,2.,weight);
         if (track->getSharedLy1())
-            Fill1DHisto(trkname+"sharingHits_h",3.,weight);
+            Fill1DHisto(h.sharingHits,3.,weight);
         if (track->getSharedLy0() && track->getSharedLy1())
-            Fill1DHisto(trkname+"sharingHits_h",4.,weight);
+            Fill1DHisto(h.sharingHits,4.,weight);
         if (!track->getSharedLy0() && !track->getSharedLy1())
-            Fill1DHisto(trkname+"sharingHits_h",5.,weight);
+            Fill1DHisto(h.sharingHits,5.,weight);
     }
 
     if (track -> is345Seed())
-        Fill1DHisto(trkname+"strategy_h",0,weight);
+        Fill1DHisto(h.strategy,0,weight);
     if (track-> is456Seed())
-        Fill1DHisto(trkname+"strategy_h",1,weight);
+        Fill1DHisto(h.strategy,1,weight);
     if (track-> is123SeedC4())
-        Fill1DHisto(trkname+"strategy_h",2,weight);
+        Fill1DHisto(h.strategy,2,weight);
     if (track->is123SeedC5())
-        Fill1DHisto(trkname+"strategy_h",3,weight);
+        Fill1DHisto(h.strategy,3,weight);
     if (track->isMatchedTrack())
-        Fill1DHisto(trkname+"strategy_h",4,weight);
+        Fill1DHisto(h.strategy,4,weight);
     if (track->isGBLTrack())
-        Fill1DHisto(trkname+"strategy_h",5,weight);
+        Fill1DHisto(h.strategy,5,weight);
 
 
-    Fill1DHisto(trkname+"type_h",track->getType(),weight);
+    Fill1DHisto(h.type,track->getType(),weight);
 }
 
 void TrackHistos::Fill1DVertex(Vertex* vtx, float weight) {
 
-    Fill1DHisto("vtx_chi2_h"   ,vtx->getChi2(),weight);
-    Fill2DHisto("vtx_XY_hh",vtx->getX(),vtx->getY(),weight);
-    Fill1DHisto("vtx_X_h"      ,vtx->getX(),weight);
-    Fill1DHisto("vtx_Y_h"      ,vtx->getY(),weight);
-    Fill1DHisto("vtx_Z_h"      ,vtx->getZ(),weight);
+    const VertexHandles& h = getVertexHandles();
+
+    Fill1DHisto(h.chi2,vtx->getChi2(),weight);
+    Fill2DHisto(h.XY,vtx->getX(),vtx->getY(),weight);
+    Fill1DHisto(h.X,vtx->getX(),weight);
+    Fill1DHisto(h.Y,vtx->getY(),weight);
+    Fill1DHisto(h.Z,vtx->getZ(),weight);
 
     TVector3 vtxPosSvt;
     vtxPosSvt.SetX(vtx->getX());
@@ -267,22 +420,22 @@ void TrackHistos::Fill1DVertex(Vertex* vtx, float weight) {
 
     vtxPosSvt.RotateY(-0.0305);
 
-    Fill2DHisto("vtx_XY_svt_hh",vtxPosSvt.X(),vtxPosSvt.Y(),weight);
-    Fill1DHisto("vtx_X_svt_h",vtxPosSvt.X(),weight);
-    Fill1DHisto("vtx_Y_svt_h",vtxPosSvt.Y(),weight);
-    Fill1DHisto("vtx_Z_svt_h",vtxPosSvt.Z(),weight);
+    Fill2DHisto(h.XY_svt,vtxPosSvt.X(),vtxPosSvt.Y(),weight);
+    Fill1DHisto(h.X_svt,vtxPosSvt.X(),weight);
+    Fill1DHisto(h.Y_svt,vtxPosSvt.Y(),weight);
+    Fill1DHisto(h.Z_svt,vtxPosSvt.Z(),weight);
 
 
     // 0 xx 1 xy 2 xz 3 yy 4 yz 5 zz
-    Fill1DHisto("vtx_sigma_X_h",sqrt(vtx->getCovariance()[0]),weight);
-    Fill1DHisto("vtx_sigma_Y_h",sqrt(vtx->getCovariance()[3]),weight);
-    Fill1DHisto("vtx_sigma_Z_h",sqrt(vtx->getCovariance()[5]),weight);
-    Fill1DHisto("vtx_InvM_h"   ,vtx->getInvMass(),weight);
-    Fill1DHisto("vtx_InvMErr_Z_h",vtx->getInvMassErr(),weight);
-    Fill1DHisto("vtx_px_h",vtx->getP().X());
-    Fill1DHisto("vtx_py_h",vtx->getP().Y());
-    Fill1DHisto("vtx_pz_h",vtx->getP().Z());
-    Fill1DHisto("vtx_p_h" ,vtx->getP().Mag());
+    Fill1DHisto(h.sigma_X,sqrt(vtx->getCovariance()[0]),weight);
+    Fill1DHisto(h.sigma_Y,sqrt(vtx->getCovariance()[3]),weight);
+    Fill1DHisto(h.sigma_Z,sqrt(vtx->getCovariance()[5]),weight);
+    Fill1DHisto(h.InvM,vtx->getInvMass(),weight);
+    Fill1DHisto(h.InvMErr,vtx->getInvMassErr(),weight);
+    Fill1DHisto(h.px,vtx->getP().X());
+    Fill1DHisto(h.py,vtx->getP().Y());
+    Fill1DHisto(h.pz,vtx->getP().Z());
+    Fill1DHisto(h.p,vtx->getP().Mag());
 }
 
 void TrackHistos::Fill1DHistograms(Track *track, Vertex* vtx, float weight ) {
@@ -331,25 +484,27 @@ void TrackHistos::Fill1DTrackTruth(Track *track, Track* truth_track, float weigh
 
     double diff_percent_invpT = ((invPt - invPt_truth) / invPt_truth) * 100.;
 
+    const TrackHandles& h = getTrackHandles(trkname);
+
     // truth residuals
-    Fill1DHisto(trkname+"d0_truth_res_h",       d0 - d0_truth                  , weight);
-    Fill1DHisto(trkname+"Phi_truth_res_h",      phi - phi_truth                , weight);
-    Fill1DHisto(trkname+"Omega_truth_res_h",    omega - omega_truth            , weight);
-    Fill1DHisto(trkname+"TanLambda_truth_res_h",tanLambda - tanLambda_truth    , weight);
-    Fill1DHisto(trkname+"Z0_truth_res_h",       z0 - z0_truth                  , weight);
-    Fill1DHisto(trkname+"p_truth_res_h",        p  - p_truth                   , weight);
-    Fill1DHisto(trkname+"invpT_truth_res_h",    invPt - invPt_truth            , weight);
-    Fill1DHisto(trkname+"invpT_truth_res_percent_h", diff_percent_invpT        , weight);
-    Fill1DHisto(trkname+"px_truth_res_h",       trk_mom[0]  - trk_truth_mom[0] , weight);
-    Fill1DHisto(trkname+"py_truth_res_h",       trk_mom[1]  - trk_truth_mom[1] , weight);
-    Fill1DHisto(trkname+"pz_truth_res_h",       trk_mom[2]  - trk_truth_mom[2] , weight);
+    Fill1DHisto(h.d0_res,            d0 - d0_truth                  , weight);
+    Fill1DHisto(h.phi_res,           phi - phi_truth                , weight);
+    Fill1DHisto(h.omega_res,         omega - omega_truth            , weight);
+    Fill1DHisto(h.tanLambda_res,     tanLambda - tanLambda_truth    , weight);
+    Fill1DHisto(h.z0_res,            z0 - z0_truth                  , weight);
+    Fill1DHisto(h.p_res,             p  - p_truth                   , weight);
+    Fill1DHisto(h.invpT_res,         invPt - invPt_truth            , weight);
+    Fill1DHisto(h.invpT_res_percent, diff_percent_invpT             , weight);
+    Fill1DHisto(h.px_res,            trk_mom[0]  - trk_truth_mom[0] , weight);
+    Fill1DHisto(h.py_res,            trk_mom[1]  - trk_truth_mom[1] , weight);
+    Fill1DHisto(h.pz_res,            trk_mom[2]  - trk_truth_mom[2] , weight);
 
     // truth pulls
-    Fill1DHisto(trkname+"d0_truth_pull_h",       (d0 - d0_truth)               / d0err, weight);
-    Fill1DHisto(trkname+"Phi_truth_pull_h",      (phi - phi_truth)             / phierr  , weight);
-    Fill1DHisto(trkname+"Omega_truth_pull_h",    (omega - omega_truth)         / omegaerr, weight);
-    Fill1DHisto(trkname+"TanLambda_truth_pull_h",(tanLambda - tanLambda_truth) / tanLambdaerr, weight);
-    Fill1DHisto(trkname+"Z0_truth_pull_h",       (z0 - z0_truth)               / z0err, weight);
+    Fill1DHisto(h.d0_pull,        (d0 - d0_truth)               / d0err, weight);
+    Fill1DHisto(h.phi_pull,       (phi - phi_truth)             / phierr  , weight);
+    Fill1DHisto(h.omega_pull,     (omega - omega_truth)         / omegaerr, weight);
+    Fill1DHisto(h.tanLambda_pull, (tanLambda - tanLambda_truth) / tanLambdaerr, weight);
+    Fill1DHisto(h.z0_pull,        (z0 - z0_truth)               / z0err, weight);
 
 }
 
@@ -369,18 +524,19 @@ void TrackHistos::Fill2DHistograms(Vertex* vtx, float weight) {
 
 
         double vtxP = vtx->getP().Mag();
+        const VertexHandles& h = getVertexHandles();
 
-        Fill2DHisto("vtx_InvM_vtx_z_hh",vtx->getInvMass(),vtx->getZ(),weight);
-        Fill2DHisto("vtx_InvM_vtx_svt_z_hh",vtx->getInvMass(),vtxPosSvt.Z(),weight);
-        Fill2DHisto("vtx_p_svt_z_hh",vtxP,vtxPosSvt.Z(),weight);
-        Fill2DHisto("vtx_p_svt_x_hh",vtxP,vtxPosSvt.X(),weight);
-        Fill2DHisto("vtx_p_svt_y_hh",vtxP,vtxPosSvt.Y(),weight);
+        Fill2DHisto(h.InvM_z,vtx->getInvMass(),vtx->getZ(),weight);
+        Fill2DHisto(h.InvM_svt_z,vtx->getInvMass(),vtxPosSvt.Z(),weight);
+        Fill2DHisto(h.p_svt_z,vtxP,vtxPosSvt.Z(),weight);
+        Fill2DHisto(h.p_svt_x,vtxP,vtxPosSvt.X(),weight);
+        Fill2DHisto(h.p_svt_y,vtxP,vtxPosSvt.Y(),weight);
 
-        Fill2DHisto("vtx_svt_y_svt_z_hh",vtxPosSvt.Y(),vtxPosSvt.Z(),weight);
+        Fill2DHisto(h.svt_y_svt_z,vtxPosSvt.Y(),vtxPosSvt.Z(),weight);
 
-        Fill2DHisto("vtx_p_sigmaZ_hh",vtxP,vtx->getCovariance()[5],weight);
-        Fill2DHisto("vtx_p_sigmaX_hh",vtxP,vtx->getCovariance()[3],weight);
-        Fill2DHisto("vtx_p_sigmaY_hh",vtxP,vtx->getCovariance()[0],weight);
+        Fill2DHisto(h.p_sigmaZ,vtxP,vtx->getCovariance()[5],weight);
+        Fill2DHisto(h.p_sigmaX,vtxP,vtx->getCovariance()[3],weight);
+        Fill2DHisto(h.p_sigmaY,vtxP,vtx->getCovariance()[0],weight);
     }
 }
 
@@ -388,13 +544,13 @@ void TrackHistos::FillTrackComparisonHistograms(Track* track_x, Track* track_y,
 
     if (doTrkCompPlots) {
         /*
-           histos2d[m_name+"_d0_vs_d0"              ]->Fill(track_x->getD0(),track_y->getD0(),weight);
-           histos2d[m_name+"_Phi_vs_Phi"            ]->Fill(track_x->getPhi(),track_y->getPhi(),weight);
-           histos2d[m_name+"_Omega_vs_Omega"        ]->Fill(track_x->getOmega(),track_y->getOmega(),weight);
-           histos2d[m_name+"_TanLambda_vs_TanLambda"]->Fill(track_x->getTanLambda(),track_y->getTanLambda(),weight);
-           histos2d[m_name+"_Z0_vs_Z0"              ]->Fill(track_x->getZ0(),track_y->getZ0(),weight);
-           histos2d[m_name+"_time_vs_time"          ]->Fill(track_x->getTrackTime(),track_y->getTrackTime(),weight);
-           histos2d[m_name+"_chi2_vs_chi2"          ]->Fill(track_x->getChi2Ndf(),
+           local2dHisto(m_name+"_d0_vs_d0"              )->Fill(track_x->getD0(),track_y->getD0(),weight);
+           local2dHisto(m_name+"_Phi_vs_Phi"            )->Fill(track_x->getPhi(),track_y->getPhi(),weight);
+           local2dHisto(m_name+"_Omega_vs_Omega"        )->Fill(track_x->getOmega(),track_y->getOmega(),weight);
+           local2dHisto(m_name+"_TanLambda_vs_TanLambda")->Fill(track_x->getTanLambda(),track_y->getTanLambda(),weight);
+           local2dHisto(m_name+"_Z0_vs_Z0"              )->Fill(track_x->getZ0(),track_y->getZ0(),weight);
+           local2dHisto(m_name+"_time_vs_time"          )->Fill(track_x->getTrackTime(),track_y->getTrackTime(),weight);
+           local2dHisto(m_name+"_chi2_vs_chi2"          )->Fill(track_x->getChi2Ndf(),
            track_y->getChi2Ndf(),
            weight);
            */
@@ -406,16 +562,17 @@ void TrackHistos::FillTrackComparisonHistograms(Track* track_x, Track* track_y,
 //Residual Plots ============ They should probably go somewhere else ====================
 
 
-void TrackHistos::FillResidualHistograms(Track* track, int ly, double res, double sigma) {
+void TrackHistos::FillResidualHistograms(Track* track, int ly, double res, double sigma, 
+        const std::vector<TrackerHit*>* hits) {
 
     double trk_mom = track->getP();
-    std::string lyr = std::to_string(ly);
+    const ResidualHandles& h = getResidualHandles(ly);
 
     TrackerHit* hit = nullptr;
     //Get the hits on track 
-    for (int ihit = 0; ihit<track->getSvtHits()->GetEntries();++ihit) {
-        TrackerHit* tmphit = (TrackerHit*) track->getSvtHits()->At(ihit);
-        if (tmphit->getLayer() == ly) {
+    for (int ihit = 0; ihit<track->getNHitLinks();++ihit) {
+        TrackerHit* tmphit = track->getHit(ihit, hits);
+        if (tmphit && tmphit->getLayer() == ly) {
             hit = tmphit;
             break;
         }
@@ -431,14 +588,14 @@ void TrackHistos::FillResidualHistograms(Track* track, int ly, double res, doubl
     }
 
     //General Plots
-    Fill1DHisto("u_res_ly_"+lyr+"_h",res);
-    Fill2DHisto("u_res_ly_"+lyr+"_vsp_hh",trk_mom,res);
-    Fill2DHisto("u_res_ly_"+lyr+"_vsy_hh",hit_y,res);
+    Fill1DHisto(h.res,res);
+    Fill2DHisto(h.res_vsp,trk_mom,res);
+    Fill2DHisto(h.res_vsy,hit_y,res);
 
     //Top = 0 bottom=1 - Per Volume
-    std::string vol = track->getTanLambda()>0 ? "top" : "bot";
-    Fill1DHisto("u_res_ly_"+lyr+"_"+vol+"_h",res);
-    Fill2DHisto("u_res_ly_"+lyr+"_"+vol+"_vsp_hh",trk_mom,res);
+    bool top = track->getTanLambda()>0;
+    Fill1DHisto(top ? h.res_top : h.res_bot,res);
+    Fill2DHisto(top ? h.res_top_vsp : h.res_bot_vsp,trk_mom,res);
 
 }
 
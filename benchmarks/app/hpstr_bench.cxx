@@ -0,0 +1,299 @@
+/**
+ *  @file   hpstr_bench.cxx
+ *  @brief  App running the processors on synthetic events and reporting
+ *          their throughput.
+ */
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//----------//
+//   ROOT   //
+//----------//
+#include <TFile.h>
+#include <TH1D.h>
+
+//-----------//
+//   hpstr   //
+//-----------//
+#include "ParameterSet.h"
+#include "Process.h"
+#include "ProcessorFactory.h"
+#include "SyntheticEventGenerator.h"
+
+using namespace std;
+
+/**
+ * @struct Benchmark
+ * @brief Configuration and results of a benchmark.
+ */
+struct Benchmark {
+
+    /** Processor of a benchmark. */
+    struct Step {
+        std::string classname_;
+        std::string instancename_;
+        ParameterSet params_;
+    };
+
+    std::string name_;
+    int run_mode_{1};
+    int threads_{1};
+    std::string input_;
+    std::string output_;
+    std::string event_list_;
+    std::vector<Step> steps_;
+
+    /** Results */
+    double wall_{0};
+    std::vector<std::pair<std::string, double> > stages_;
+};
+
+void displayUsage();
+
+/** Run a benchmark, filling its results. */
+void run(Benchmark& benchmark);
+
+/** @return The results of the benchmarks as JSON. */
+std::string toJson(const std::vector<Benchmark>& benchmarks, long n_events, unsigned int seed);
+
+int main(int argc, char **argv) {
+
+    long n_events = 1000;
+    unsigned int seed = 1;
+    int threads = 0;
+    std::string workdir = ".";
+    std::string json;
+    std::string library = "libprocessors.so";
+
+    for (int iarg = 1; iarg < argc; ++iarg) {
+        std::string arg(argv[iarg]);
+        if (arg == "-h" || arg == "--help") {
+            displayUsage();
+            return EXIT_SUCCESS;
+        }
+        if (iarg + 1 == argc) {
+            displayUsage();
+            return EXIT_FAILURE;
+        }
+        if (arg == "-n") {
+            n_events = atol(argv[++iarg]);
+        } else if (arg == "-s") {
+            seed = atoi(argv[++iarg]);
+        } else if (arg == "-t") {
+            threads = atoi(argv[++iarg]);
+        } else if (arg == "-w") {
+            workdir = argv[++iarg];
+        } else if (arg == "-o") {
+            json = argv[++iarg];
+        } else if (arg == "-l") {
+            library = argv[++iarg];
+        } else {
+            displayUsage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    try {
+
+        std::string lcio_file = workdir + "/hpstr_bench_events.slcio";
+        std::string dst_file = workdir + "/hpstr_bench_dst.root";
+        std::string list_file = workdir + "/hpstr_bench_events.txt";
+
+        std::cout << "---- [ hpstr-bench ]: Generating " << n_events << " events with seed "
+            << seed << " --------" << std::endl;
+        SyntheticEventGenerator generator(seed);
+        generator.writeLcio(lcio_file, n_events);
+        generator.writeEventList(list_file, n_events, 10);
+
+        ProcessorFactory::instance().loadLibrary(library);
+
+        std::vector<Benchmark> benchmarks;
+
+        // LCIO -> DST conversion, also producing the input of the other benchmarks
+        Benchmark convert;
+        convert.name_ = "lcio_to_dst";
+        convert.run_mode_ = 0;
+        convert.input_ = lcio_file;
+        convert.output_ = dst_file;
+        convert.steps_ = {
+            {"EventProcessor", "header", {}},
+            {"SvtRawDataProcessor", "svtrawhits", {}},
+            {"TrackingProcessor", "tracks", {}},
+            {"ECalDataProcessor", "ecal", {}},
+            {"VertexProcessor", "vertices", {}},
+            {"MCParticleProcessor", "mcparticles", {}}
+        };
+        benchmarks.push_back(convert);
+
+        // The analysis processors read their histogram and selection
+        // configurations from the source tree
+        const char* base = getenv("HPSTR_BASE");
+        if (base) {
+            std::string hpstr_base(base);
+
+            Benchmark tracking;
+            tracking.name_ = "tracking_ana";
+            tracking.input_ = dst_file;
+            tracking.output_ = workdir + "/hpstr_bench_tracking.root";
+            Benchmark::Step track_ana{"TrackingAnaProcessor", "trackana", {}};
+            track_ana.params_.insert("trkCollName", std::string("GBLTracks"));
+            track_ana.params_.insert("histCfg", hpstr_base + "/analysis/plotconfigs/tracking/basicTracking.json");
+            Benchmark::Step hit_ana{"TrackHitAnaProcessor", "trackhitana", {}};
+            hit_ana.params_.insert("trkCollName", std::string("GBLTracks"));
+            hit_ana.params_.insert("hitCollName", std::string("RotatedHelicalOnTrackHits"));
+            hit_ana.params_.insert("histCfg", hpstr_base + "/analysis/plotconfigs/tracking/trackHit.json");
+            hit_ana.params_.insert("selectionjson", hpstr_base + "/analysis/selections/trackHit/trackHitAna.json");
+            tracking.steps_ = {track_ana, hit_ana};
+            benchmarks.push_back(tracking);
+
+            Benchmark vertex;
+            vertex.name_ = "vertex_ana";
+            vertex.input_ = dst_file;
+            vertex.output_ = workdir + "/hpstr_bench_vertex.root";
+            Benchmark::Step vtx_ana{"VertexAnaProcessor", "vtxana", {}};
+            vtx_ana.params_.insert("anaName", std::string("vtxana"));
+            vtx_ana.params_.insert("analysis", std::string("vertex"));
+            vtx_ana.params_.insert("vtxColl", std::string("UnconstrainedV0Vertices"));
+            vtx_ana.params_.insert("trkColl", std::string("GBLTracks"));
+            vtx_ana.params_.insert("hitColl", std::string("RotatedHelicalOnTrackHits"));
+            vtx_ana.params_.insert("mcColl", std::string("MCParticle"));
+            vtx_ana.params_.insert("vtxSelectionjson", hpstr_base + "/analysis/selections/vertexSelection_2019.json");
+            vtx_ana.params_.insert("histoCfg", hpstr_base + "/analysis/plotconfigs/tracking/vtxAnalysis_2019.json");
+            vtx_ana.params_.insert("mcHistoCfg", hpstr_base + "/analysis/plotconfigs/mc/basicMC.json");
+            vtx_ana.params_.insert("beamE", 4.55);
+            vtx_ana.params_.insert("isData", 0);
+            vtx_ana.params_.insert("CalTimeOffset", 0.);
+            vtx_ana.params_.insert("regionDefinitions", std::vector<std::string>());
+            vertex.steps_ = {vtx_ana};
+            benchmarks.push_back(vertex);
+
+            if (threads > 1) {
+                Benchmark threaded = tracking;
+                threaded.name_ = "tracking_ana_threads" + std::to_string(threads);
+                threaded.threads_ = threads;
+                threaded.output_ = workdir + "/hpstr_bench_tracking_mt.root";
+                benchmarks.push_back(threaded);
+            }
+
+            Benchmark list = tracking;
+            list.name_ = "tracking_ana_event_list";
+            list.run_mode_ = 3;
+            list.event_list_ = list_file;
+            list.output_ = workdir + "/hpstr_bench_event_list.root";
+            benchmarks.push_back(list);
+        } else {
+            std::cout << "---- [ hpstr-bench ]: HPSTR_BASE isn't set, skipping the analysis benchmarks --------"
+                << std::endl;
+        }
+
+        for (auto& benchmark : benchmarks) {
+            std::cout << "---- [ hpstr-bench ]: Running " << benchmark.name_ << " --------" << std::endl;
+            run(benchmark);
+            std::cout << "---- [ hpstr-bench ]: " << benchmark.name_ << " took " << benchmark.wall_
+                << " s --------" << std::endl;
+        }
+
+        std::string results = toJson(benchmarks, n_events, seed);
+        if (json.empty()) {
+            std::cout << results;
+        } else {
+            std::ofstream out(json);
+            if (!out)
+                throw std::runtime_error("Unable to open " + json);
+            out << results;
+        }
+
+    } catch (exception& e) {
+        std::cerr << "Error! [" << e.what() << "] \n";
+        std::cerr << "Program aborted. " << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+void run(Benchmark& benchmark) {
+
+    Process* p = new Process();
+    p->setRunMode(benchmark.run_mode_);
+    p->setThreads(benchmark.threads_);
+    p->setTiming(true);
+    if (!benchmark.event_list_.empty()) p->setEventList(benchmark.event_list_);
+
+    for (auto& step : benchmark.steps_) {
+        Processor* ep = ProcessorFactory::instance().createProcessor(step.classname_, step.instancename_, *p);
+        if (ep == 0) {
+            throw std::runtime_error("[ hpstr-bench ]: Unable to create instance of " + step.instancename_);
+        }
+        ep->configure(step.params_);
+        p->addToSequence(ep);
+        p->addProcessorConfig(step.classname_, step.instancename_, step.params_);
+    }
+    p->addFileToProcess(benchmark.input_);
+    p->addOutputFileName(benchmark.output_);
+
+    auto start = std::chrono::steady_clock::now();
+    if (benchmark.run_mode_ == 0) p->run();
+    else if (benchmark.run_mode_ == 1) p->runOnRoot();
+    else if (benchmark.run_mode_ == 3) p->runOnEventList();
+    else throw std::runtime_error("[ hpstr-bench ]: Unsupported run mode " + std::to_string(benchmark.run_mode_));
+    benchmark.wall_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // The processing time of each stage, as recorded by the process
+    TFile output(benchmark.output_.c_str());
+    auto timing = output.IsOpen() ? dynamic_cast<TH1D*>(output.Get("processing_time_h")) : nullptr;
+    if (timing) {
+        for (int ibin = 1; ibin <= timing->GetNbinsX(); ++ibin) {
+            benchmark.stages_.emplace_back(timing->GetXaxis()->GetBinLabel(ibin), timing->GetBinContent(ibin));
+        }
+    }
+}
+
+std::string toJson(const std::vector<Benchmark>& benchmarks, long n_events, unsigned int seed) {
+
+    // The run mode 3 benchmark only processes the listed events
+    auto eventsOf = [n_events](const Benchmark& benchmark) -> double {
+        return benchmark.run_mode_ == 3 ? (n_events + 9)/10 : n_events;
+    };
+
+    std::stringstream json;
+    json << std::setprecision(6);
+    json << "{\n  \"events\": " << n_events << ",\n  \"seed\": " << seed << ",\n  \"benchmarks\": [\n";
+    for (std::size_t ibench = 0; ibench < benchmarks.size(); ++ibench) {
+        const Benchmark& benchmark = benchmarks[ibench];
+        double events = eventsOf(benchmark);
+        json << "    {\"name\": \"" << benchmark.name_ << "\", \"run_mode\": " << benchmark.run_mode_
+            << ", \"threads\": " << benchmark.threads_ << ", \"events\": " << events
+            << ", \"wall_s\": " << benchmark.wall_
+            << ", \"events_per_s\": " << (benchmark.wall_ > 0 ? events/benchmark.wall_ : 0)
+            << ", \"ns_per_event\": " << (events > 0 ? 1e9*benchmark.wall_/events : 0)
+            << ",\n     \"stages\": [";
+        for (std::size_t istage = 0; istage < benchmark.stages_.size(); ++istage) {
+            const auto& stage = benchmark.stages_[istage];
+            json << (istage ? ",\n                " : "") << "{\"name\": \"" << stage.first
+                << "\", \"total_s\": " << stage.second
+                << ", \"ns_per_event\": " << (events > 0 ? 1e9*stage.second/events : 0)
+                << ", \"events_per_s\": " << (stage.second > 0 ? events/stage.second : 0) << "}";
+        }
+        json << "]}" << (ibench + 1 < benchmarks.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+    return json.str();
+}
+
+void displayUsage() {
+    printf("Usage: hpstr-bench [-n events] [-s seed] [-t threads] [-w workdir] [-o results.json]"
+            " [-l processor library]\n");
+}
@@ -0,0 +1,132 @@
+/**
+ * @file SyntheticEventGenerator.h
+ * @brief Class generating deterministic, synthetic LCIO events used to
+ *        benchmark the processors.
+ */
+
+#ifndef __SYNTHETIC_EVENT_GENERATOR_H__
+#define __SYNTHETIC_EVENT_GENERATOR_H__
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <random>
+#include <string>
+
+//----------//
+//   LCIO   //
+//----------//
+#include <IMPL/LCEventImpl.h>
+
+/**
+ * @class SyntheticEventGenerator
+ * @brief Generates LCIO events with the collections read by the DST
+ *        conversion processors, with multiplicities close to the ones of
+ *        the physics runs.
+ *
+ * Each event holds:
+ *   - the trigger bank and the RF hits read by EventProcessor
+ *   - SVTRawTrackerHits, their shape fits and the SVTFittedRawTrackerHits
+ *     relations, read by SvtRawDataProcessor
+ *   - GBLTracks with their 3D hits, GBL kink data and track data, read by
+ *     TrackingProcessor
+ *   - EcalCalHits and EcalClustersCorr, read by ECalDataProcessor
+ *   - UnconstrainedV0Vertices and their particles, read by VertexProcessor
+ *   - MCParticle, read by MCParticleProcessor
+ *
+ * The content is fully determined by the seed.  The numbers are drawn
+ * from the raw std::mt19937 output, whose sequence is specified by the
+ * standard, rather than through the std distributions, whose algorithms
+ * are left to the standard library, so the same events are generated with
+ * libstdc++ and libc++.  Only the last bits of the values passed through
+ * std::log, std::exp or std::cos may differ between math libraries.
+ * Converting the events
+ * with the default processor settings produces the DST used by the
+ * analysis benchmarks.
+ */
+class SyntheticEventGenerator {
+
+    public:
+
+        /**
+         * @struct Multiplicities
+         * @brief Mean number of objects per event.
+         */
+        struct Multiplicities {
+            double tracks_{4};
+            int hits_per_track_{6};
+            int raw_hits_per_hit_{4};
+            double noise_raw_hits_{150};
+            double ecal_hits_{30};
+            double clusters_{3};
+            double vertices_{1};
+            double mc_particles_{20};
+        };
+
+        /**
+         * Constructor
+         *
+         * @param seed Seed of the random number generator
+         * @param run Run number of the events
+         */
+        SyntheticEventGenerator(unsigned int seed = 1, int run = 10000);
+
+        /** @param multiplicities The mean number of objects per event. */
+        void setMultiplicities(const Multiplicities& multiplicities) {
+            multiplicities_ = multiplicities;
+        }
+
+        /**
+         * Generate an event.  The event number is incremented on each call.
+         *
+         * @return The event, owned by the caller
+         */
+        IMPL::LCEventImpl* generate();
+
+        /**
+         * Write events to an LCIO file.
+         *
+         * @param filename Name of the output file
+         * @param n_events Number of events
+         */
+        void writeLcio(const std::string& filename, int n_events);
+
+        /**
+         * Write a run/event list of the events that would be generated,
+         * as read in run mode 3.
+         *
+         * @param filename Name of the output file
+         * @param n_events Number of generated events
+         * @param stride Distance between the listed events
+         */
+        void writeEventList(const std::string& filename, int n_events, int stride) const;
+
+    private:
+
+        /** Draw a uniform number in [0, 1) with 53 random bits. */
+        double uniform();
+
+        /** Draw a multiplicity from a Poisson distribution, with Knuth's method. */
+        int poisson(double mean);
+
+        /** Draw a uniform number in [min, max). */
+        double uniform(double min, double max);
+
+        /** Draw a normally distributed number, with the Box-Muller transform. */
+        double gauss(double mean, double sigma);
+
+        /** Random number engine. */
+        std::mt19937 engine_;
+
+        /** Mean number of objects per event. */
+        Multiplicities multiplicities_;
+
+        /** Run number of the events. */
+        int run_{10000};
+
+        /** Number of the next event. */
+        int event_{0};
+
+}; // SyntheticEventGenerator
+
+#endif // __SYNTHETIC_EVENT_GENERATOR_H__
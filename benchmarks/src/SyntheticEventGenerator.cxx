@@ -0,0 +1,440 @@
+/**
+ * @file SyntheticEventGenerator.cxx
+ * @brief Class generating deterministic, synthetic LCIO events used to
+ *        benchmark the processors.
+ */
+
+#include "SyntheticEventGenerator.h"
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <cmath>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+//----------//
+//   LCIO   //
+//----------//
+#include <EVENT/LCIO.h>
+#include <EVENT/TrackState.h>
+#include <IMPL/CalorimeterHitImpl.h>
+#include <IMPL/ClusterImpl.h>
+#include <IMPL/LCCollectionVec.h>
+#include <IMPL/LCGenericObjectImpl.h>
+#include <IMPL/LCRelationImpl.h>
+#include <IMPL/MCParticleImpl.h>
+#include <IMPL/ParticleIDImpl.h>
+#include <IMPL/ReconstructedParticleImpl.h>
+#include <IMPL/TrackImpl.h>
+#include <IMPL/TrackStateImpl.h>
+#include <IMPL/TrackerHitImpl.h>
+#include <IMPL/TrackerRawDataImpl.h>
+#include <IMPL/VertexImpl.h>
+#include <IO/LCWriter.h>
+#include <IOIMPL/LCFactory.h>
+#include <UTIL/BitField64.h>
+
+namespace {
+
+    /** Encoding of the SVT raw hit cell IDs, as decoded by the SVT processors. */
+    const std::string SVT_ENCODING{"system:6,barrel:3,layer:4,module:12,sensor:1,side:32:-2,strip:12"};
+
+    /** Encoding of the Ecal hit cell IDs, as decoded by ECalDataProcessor. */
+    const std::string ECAL_ENCODING{"system:6,layer:2,ix:-8,iy:-6"};
+
+    /** Number of 3D hit layers of the tracker. */
+    const int N_LAYERS{7};
+
+    /** Number of strips per sensor. */
+    const int N_STRIPS{640};
+
+    /** 2 pi, M_PI isn't standard C++. */
+    const double TWO_PI{6.283185307179586};
+
+    /** Make a relation collection. */
+    IMPL::LCCollectionVec* makeRelations(const std::string& from, const std::string& to) {
+        auto relations = new IMPL::LCCollectionVec(EVENT::LCIO::LCRELATION);
+        relations->parameters().setValue("FromType", from);
+        relations->parameters().setValue("ToType", to);
+        return relations;
+    }
+}
+
+SyntheticEventGenerator::SyntheticEventGenerator(unsigned int seed, int run)
+    : engine_(seed), run_(run) {
+}
+
+double SyntheticEventGenerator::uniform() {
+    // Same as genrand_res53 of the reference implementation of the engine
+    double high = engine_() >> 5;
+    double low = engine_() >> 6;
+    return (high*67108864. + low)/9007199254740992.;
+}
+
+int SyntheticEventGenerator::poisson(double mean) {
+    // exp(-mean) underflows for large means, which are drawn in parts
+    int n = 0;
+    for (; mean > 500; mean -= 500) n += poisson(500);
+    double limit = std::exp(-mean);
+    for (double product = uniform(); product > limit; product *= uniform()) ++n;
+    return n;
+}
+
+double SyntheticEventGenerator::uniform(double min, double max) {
+    return min + (max - min)*uniform();
+}
+
+double SyntheticEventGenerator::gauss(double mean, double sigma) {
+    // 1 - u is in (0, 1], so the logarithm is finite
+    double radius = std::sqrt(-2.*std::log(1. - uniform()));
+    return mean + sigma*radius*std::cos(TWO_PI*uniform());
+}
+
+IMPL::LCEventImpl* SyntheticEventGenerator::generate() {
+
+    auto event = new IMPL::LCEventImpl();
+    event->setRunNumber(run_);
+    event->setEventNumber(event_++);
+    event->setTimeStamp(4*(long64)event->getEventNumber()*1000);
+
+    //---------------------------//
+    //   Trigger and RF times    //
+    //---------------------------//
+    auto triggers = new IMPL::LCCollectionVec(EVENT::LCIO::LCGENERICOBJECT);
+    auto trigger = new IMPL::LCGenericObjectImpl();
+    trigger->setIntVal(0, 0xe10a);
+    trigger->setIntVal(1, 1 << (24 + event->getEventNumber() % 4));
+    trigger->setIntVal(2, 0);
+    trigger->setIntVal(3, event->getEventNumber());
+    trigger->setIntVal(4, 0);
+    triggers->addElement(trigger);
+    event->addCollection(triggers, "TriggerBank");
+
+    auto rf_hits = new IMPL::LCCollectionVec(EVENT::LCIO::LCGENERICOBJECT);
+    auto rf_hit = new IMPL::LCGenericObjectImpl();
+    rf_hit->setDoubleVal(0, uniform(0, 4));
+    rf_hit->setDoubleVal(1, uniform(0, 4));
+    rf_hits->addElement(rf_hit);
+    event->addCollection(rf_hits, "RFHits");
+
+    //---------------------//
+    //   SVT raw hits      //
+    //---------------------//
+    auto raw_hits = new IMPL::LCCollectionVec(EVENT::LCIO::TRACKERRAWDATA);
+    auto fits = new IMPL::LCCollectionVec(EVENT::LCIO::LCGENERICOBJECT);
+    auto fit_relations = makeRelations(EVENT::LCIO::TRACKERRAWDATA, EVENT::LCIO::LCGENERICOBJECT);
+    UTIL::BitField64 svt_encoder(SVT_ENCODING);
+
+    auto makeRawHit = [&](int layer, int module, int strip, double amplitude, double t0) {
+        svt_encoder.reset();
+        svt_encoder["system"] = 2;
+        svt_encoder["barrel"] = 0;
+        svt_encoder["layer"]  = layer;
+        svt_encoder["module"] = module;
+        svt_encoder["sensor"] = 0;
+        svt_encoder["side"]   = 0;
+        svt_encoder["strip"]  = strip;
+
+        auto raw_hit = new IMPL::TrackerRawDataImpl();
+        raw_hit->setCellID0(svt_encoder.lowWord());
+        raw_hit->setCellID1(svt_encoder.highWord());
+        raw_hit->setTime((int) t0);
+        EVENT::ShortVec adcs(6);
+        for (int isample = 0; isample < 6; ++isample) {
+            double t = isample*24. - t0;
+            double pulse = t > 0 ? amplitude*(t/40.)*std::exp(1 - t/40.) : 0;
+            adcs[isample] = (short) (4000 + pulse + gauss(0, 20));
+        }
+        raw_hit->setADCValues(adcs);
+        raw_hits->addElement(raw_hit);
+
+        auto fit = new IMPL::LCGenericObjectImpl();
+        fit->setDoubleVal(0, t0);
+        fit->setDoubleVal(1, std::fabs(gauss(2, 0.5)));
+        fit->setDoubleVal(2, amplitude);
+        fit->setDoubleVal(3, std::fabs(gauss(50, 10)));
+        fit->setDoubleVal(4, std::fabs(gauss(1, 0.5)));
+        fits->addElement(fit);
+        fit_relations->addElement(new IMPL::LCRelationImpl(raw_hit, fit));
+        return raw_hit;
+    };
+
+    int n_noise = poisson(multiplicities_.noise_raw_hits_);
+    for (int ihit = 0; ihit < n_noise; ++ihit) {
+        makeRawHit(1 + (int) uniform(0, 2*N_LAYERS), 2*(int) uniform(0, 2) + (int) uniform(0, 2),
+                (int) uniform(0, N_STRIPS), uniform(100, 500), uniform(-20, 60));
+    }
+
+    //---------------------//
+    //   Tracks            //
+    //---------------------//
+    auto tracker_hits = new IMPL::LCCollectionVec(EVENT::LCIO::TRACKERHIT);
+    auto tracks = new IMPL::LCCollectionVec(EVENT::LCIO::TRACK);
+    auto kinks = new IMPL::LCCollectionVec(EVENT::LCIO::LCGENERICOBJECT);
+    auto kink_relations = makeRelations(EVENT::LCIO::LCGENERICOBJECT, EVENT::LCIO::TRACK);
+    auto track_data = new IMPL::LCCollectionVec(EVENT::LCIO::LCGENERICOBJECT);
+    auto track_data_relations = makeRelations(EVENT::LCIO::LCGENERICOBJECT, EVENT::LCIO::TRACK);
+
+    int n_tracks = poisson(multiplicities_.tracks_);
+    for (int itrack = 0; itrack < n_tracks; ++itrack) {
+
+        int volume = (int) uniform(0, 2);
+        double charge = itrack % 2 ? 1 : -1;
+        double p = uniform(0.3, 4.0);
+        double tan_lambda = (volume ? -1 : 1)*uniform(0.015, 0.08);
+        double phi = gauss(0, 0.05);
+        double time = gauss(0, 2);
+
+        auto track = new IMPL::TrackImpl();
+        track->setType(0);
+        track->setD0(gauss(0, 0.5));
+        track->setPhi(phi);
+        track->setOmega(-charge*0.0003/p);
+        track->setTanLambda(tan_lambda);
+        track->setZ0(gauss(0, 0.3));
+        track->setChi2(std::fabs(gauss(10, 5)));
+        track->setNdf(2*multiplicities_.hits_per_track_ - 5);
+        EVENT::FloatVec covariance(15);
+        for (auto& value : covariance) value = gauss(0, 1e-4);
+        for (int idiag = 0, index = 0; idiag < 5; index += idiag + 2, ++idiag)
+            covariance[index] = std::fabs(gauss(1e-3, 1e-4));
+        track->setCovMatrix(covariance);
+
+        auto state = new IMPL::TrackStateImpl();
+        state->setLocation(EVENT::TrackState::AtCalorimeter);
+        float reference[3] = { 1394.f, (float) (1394*std::tan(phi)), (float) (1394*tan_lambda) };
+        state->setReferencePoint(reference);
+        track->addTrackState(state);
+
+        // The 3D hits of the track, one per layer, each made of strip
+        // clusters on the axial and stereo sensors
+        int n_hits = std::min(multiplicities_.hits_per_track_, N_LAYERS);
+        int first_layer = N_LAYERS - n_hits;
+        for (int ilayer = first_layer; ilayer < N_LAYERS; ++ilayer) {
+            double z = 100.*(ilayer + 1);
+            auto hit = new IMPL::TrackerHitImpl();
+            double position[3] = { z*std::tan(phi), z*tan_lambda, z };
+            hit->setPosition(position);
+            EVENT::FloatVec hit_covariance{1e-4f, 0.f, 1e-4f, 0.f, 0.f, 1e-2f};
+            hit->setCovMatrix(hit_covariance);
+            hit->setTime(time + gauss(0, 2));
+            hit->setEDep(uniform(2e-5, 8e-5));
+            int strip = (int) uniform(0, N_STRIPS - multiplicities_.raw_hits_per_hit_);
+            for (int iraw = 0; iraw < multiplicities_.raw_hits_per_hit_; ++iraw) {
+                int layer = 2*ilayer + 1 + iraw % 2;
+                hit->rawHits().push_back(makeRawHit(layer, 2*(iraw/2) + volume,
+                            strip + iraw/2, uniform(500, 2500), time + 30 + gauss(0, 3)));
+            }
+            tracker_hits->addElement(hit);
+            track->addHit(hit);
+        }
+        tracks->addElement(track);
+
+        auto kink = new IMPL::LCGenericObjectImpl();
+        for (int ikink = 0; ikink < 14; ++ikink) {
+            kink->setFloatVal(ikink, gauss(0, 1e-4));
+            kink->setDoubleVal(ikink, gauss(0, 1e-4));
+        }
+        kinks->addElement(kink);
+        kink_relations->addElement(new IMPL::LCRelationImpl(kink, track));
+
+        auto datum = new IMPL::LCGenericObjectImpl();
+        for (int iiso = 0; iiso < 14; ++iiso) datum->setDoubleVal(iiso, uniform(0, 5));
+        datum->setFloatVal(0, time);
+        datum->setFloatVal(1, p*std::sin(phi));
+        datum->setFloatVal(2, p*tan_lambda);
+        datum->setFloatVal(3, p*std::cos(phi));
+        datum->setIntVal(0, volume);
+        track_data->addElement(datum);
+        track_data_relations->addElement(new IMPL::LCRelationImpl(datum, track));
+    }
+
+    //---------------------//
+    //   Ecal              //
+    //---------------------//
+    auto ecal_hits = new IMPL::LCCollectionVec(EVENT::LCIO::CALORIMETERHIT);
+    auto clusters = new IMPL::LCCollectionVec(EVENT::LCIO::CLUSTER);
+    UTIL::BitField64 ecal_encoder(ECAL_ENCODING);
+    std::set<std::pair<int, int> > crystals;
+
+    auto makeEcalHit = [&](int ix, int iy, double energy, double time) -> IMPL::CalorimeterHitImpl* {
+        if (ix == 0 || ix < -23 || ix > 23 || iy == 0 || iy < -5 || iy > 5) return nullptr;
+        if (!crystals.insert(std::make_pair(ix, iy)).second) return nullptr;
+        ecal_encoder.reset();
+        ecal_encoder["system"] = 1;
+        ecal_encoder["layer"]  = 1;
+        ecal_encoder["ix"]     = ix;
+        ecal_encoder["iy"]     = iy;
+        auto hit = new IMPL::CalorimeterHitImpl();
+        hit->setCellID0(ecal_encoder.lowWord());
+        hit->setCellID1(ecal_encoder.highWord());
+        hit->setEnergy(energy);
+        hit->setTime(time);
+        float position[3] = { (float) (15.*ix), (float) (15.*iy), 1394.f };
+        hit->setPosition(position);
+        ecal_hits->addElement(hit);
+        return hit;
+    };
+
+    int n_clusters = poisson(multiplicities_.clusters_);
+    for (int icluster = 0; icluster < n_clusters; ++icluster) {
+        int ix = (int) uniform(-23, 23);
+        int iy = (icluster % 2 ? -1 : 1)*(1 + (int) uniform(0, 5));
+        double energy = uniform(0.2, 3.0);
+        double time = gauss(40, 2);
+        auto cluster = new IMPL::ClusterImpl();
+        double sum = 0;
+        for (int dx = -1; dx <= 1; ++dx) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                double fraction = dx == 0 && dy == 0 ? 0.7 : 0.3/8;
+                auto hit = makeEcalHit(ix + dx, iy + dy, energy*fraction, time + gauss(0, 0.5));
+                if (!hit) continue;
+                cluster->addHit(hit, 1.);
+                sum += hit->getEnergy();
+            }
+        }
+        if (sum == 0) {
+            delete cluster;
+            continue;
+        }
+        cluster->setEnergy(sum);
+        float position[3] = { (float) (15.*ix), (float) (15.*iy), 1394.f };
+        cluster->setPosition(position);
+        clusters->addElement(cluster);
+    }
+    int n_ecal_noise = std::max(poisson(multiplicities_.ecal_hits_) - ecal_hits->getNumberOfElements(), 0);
+    for (int ihit = 0; ihit < n_ecal_noise; ++ihit) {
+        makeEcalHit((int) uniform(-23, 24), (int) uniform(-5, 6), uniform(0.005, 0.1), uniform(0, 100));
+    }
+
+    //---------------------//
+    //   Vertices          //
+    //---------------------//
+    auto final_state = new IMPL::LCCollectionVec(EVENT::LCIO::RECONSTRUCTEDPARTICLE);
+    auto candidates = new IMPL::LCCollectionVec(EVENT::LCIO::RECONSTRUCTEDPARTICLE);
+    auto vertices = new IMPL::LCCollectionVec(EVENT::LCIO::VERTEX);
+
+    auto makeParticle = [&](int pdg, EVENT::Track* track, EVENT::Cluster* cluster) {
+        auto particle = new IMPL::ReconstructedParticleImpl();
+        double p = uniform(0.3, 3.0);
+        double momentum[3] = { gauss(0, 0.05)*p, gauss(0, 0.04)*p, p };
+        particle->setMomentum(momentum);
+        particle->setEnergy(p);
+        particle->setMass(0.000511);
+        particle->setCharge(pdg > 0 ? -1 : 1);
+        particle->setType(1);
+        particle->setGoodnessOfPID(uniform(0, 10));
+        auto pid = new IMPL::ParticleIDImpl();
+        pid->setPDG(pdg);
+        particle->addParticleID(pid);
+        particle->setParticleIDUsed(pid);
+        if (track) particle->addTrack(track);
+        if (cluster) particle->addCluster(cluster);
+        final_state->addElement(particle);
+        return particle;
+    };
+
+    int n_vertices = n_tracks >= 2 ? poisson(multiplicities_.vertices_) : 0;
+    for (int ivertex = 0; ivertex < n_vertices; ++ivertex) {
+        auto electron_track = static_cast<EVENT::Track*>(tracks->getElementAt((2*ivertex) % n_tracks));
+        auto positron_track = static_cast<EVENT::Track*>(tracks->getElementAt((2*ivertex + 1) % n_tracks));
+        EVENT::Cluster* electron_cluster = n_clusters > 0 && clusters->getNumberOfElements() > 0
+            ? static_cast<EVENT::Cluster*>(clusters->getElementAt(0)) : nullptr;
+
+        auto candidate = new IMPL::ReconstructedParticleImpl();
+        candidate->addParticle(makeParticle(11, electron_track, electron_cluster));
+        candidate->addParticle(makeParticle(-11, positron_track, nullptr));
+        candidate->setType(1);
+        candidate->setMass(uniform(0.02, 0.2));
+        auto pid = new IMPL::ParticleIDImpl();
+        pid->setPDG(622);
+        candidate->addParticleID(pid);
+        candidate->setParticleIDUsed(pid);
+        candidates->addElement(candidate);
+
+        auto vertex = new IMPL::VertexImpl();
+        vertex->setAlgorithmType("TargetConstrained");
+        vertex->setChi2(std::fabs(gauss(5, 3)));
+        vertex->setProbability(uniform(0, 1));
+        float position[3] = { (float) gauss(0, 0.3), (float) gauss(0, 0.1), (float) gauss(-4.3, 5) };
+        vertex->setPosition(position);
+        EVENT::FloatVec covariance{0.01f, 0.f, 0.01f, 0.f, 0.f, 1.f};
+        vertex->setCovMatrix(covariance);
+        for (int iparameter = 0; iparameter < 24; ++iparameter)
+            vertex->addParameter(gauss(0, 0.5));
+        vertex->setAssociatedParticle(candidate);
+        vertices->addElement(vertex);
+    }
+
+    //---------------------//
+    //   MC particles      //
+    //---------------------//
+    auto mc_particles = new IMPL::LCCollectionVec(EVENT::LCIO::MCPARTICLE);
+    int n_mc = poisson(multiplicities_.mc_particles_);
+    IMPL::MCParticleImpl* mother{nullptr};
+    for (int iparticle = 0; iparticle < n_mc; ++iparticle) {
+        auto particle = new IMPL::MCParticleImpl();
+        int pdg = iparticle == 0 ? 622 : (iparticle % 3 == 0 ? 22 : (iparticle % 2 ? 11 : -11));
+        particle->setPDG(pdg);
+        particle->setCharge(pdg == 11 ? -1 : (pdg == -11 ? 1 : 0));
+        particle->setMass(pdg == 22 ? 0 : (pdg == 622 ? 0.1 : 0.000511));
+        double p = uniform(0.05, 4.0);
+        double momentum[3] = { gauss(0, 0.05)*p, gauss(0, 0.04)*p, p };
+        particle->setMomentum(momentum);
+        double vertex[3] = { gauss(0, 0.3), gauss(0, 0.1), gauss(-4.3, 5) };
+        particle->setVertex(vertex);
+        double endpoint[3] = { vertex[0] + momentum[0], vertex[1] + momentum[1], 1394. };
+        particle->setEndpoint(endpoint);
+        particle->setTime(uniform(0, 2));
+        particle->setGeneratorStatus(iparticle < 3 ? 1 : 0);
+        particle->setSimulatorStatus(0);
+        if (mother) particle->addParent(mother);
+        else mother = particle;
+        mc_particles->addElement(particle);
+    }
+
+    event->addCollection(raw_hits, "SVTRawTrackerHits");
+    event->addCollection(fits, "SVTShapeFitParameters");
+    event->addCollection(fit_relations, "SVTFittedRawTrackerHits");
+    event->addCollection(tracker_hits, "RotatedHelicalTrackHits");
+    event->addCollection(tracks, "GBLTracks");
+    event->addCollection(kinks, "GBLKinkData");
+    event->addCollection(kink_relations, "GBLKinkDataRelations");
+    event->addCollection(track_data, "TrackData");
+    event->addCollection(track_data_relations, "TrackDataRelations");
+    event->addCollection(ecal_hits, "EcalCalHits");
+    event->addCollection(clusters, "EcalClustersCorr");
+    event->addCollection(final_state, "FinalStateParticles");
+    event->addCollection(candidates, "UnconstrainedV0Candidates");
+    event->addCollection(vertices, "UnconstrainedV0Vertices");
+    event->addCollection(mc_particles, "MCParticle");
+
+    return event;
+}
+
+void SyntheticEventGenerator::writeLcio(const std::string& filename, int n_events) {
+
+    IO::LCWriter* writer = IOIMPL::LCFactory::getInstance()->createLCWriter();
+    writer->open(filename, EVENT::LCIO::WRITE_NEW);
+    for (int ievent = 0; ievent < n_events; ++ievent) {
+        IMPL::LCEventImpl* event = generate();
+        writer->writeEvent(event);
+        delete event;
+    }
+    writer->close();
+    delete writer;
+}
+
+void SyntheticEventGenerator::writeEventList(const std::string& filename, int n_events, int stride) const {
+
+    std::ofstream list(filename);
+    if (!list)
+        throw std::runtime_error("[ SyntheticEventGenerator ]: Unable to open " + filename);
+    for (int ievent = 0; ievent < n_events; ievent += stride) {
+        list << run_ << " " << ievent << "\n";
+    }
+}
@@ -12,6 +12,8 @@
 //   C++ StdLib   //
 //----------------//
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 //----------//
 //   LCIO   //
@@ -52,15 +54,49 @@ class Event : public IEvent {
          *
          * @param name Name of the collection
          * @param collection The TClonesArray containing the object. 
+         * @param bufsize Basket size of the branch
+         * @param splitlevel Split level of the branch
          */
-        void addCollection(const std::string name, TClonesArray* collection);
-
-        /**  TODO fix docu
-         * Add a collection (std::vector) of objects to the event. */
+        void addCollection(const std::string name, TClonesArray* collection, 
+                int bufsize = 1000000, int splitlevel = 3);
 
+        /** 
+         * Add a collection (std::vector) of objects to the event. 
+         *
+         * @param name Name of the collection
+         * @param collection The vector containing the objects.  It needs to 
+         *     outlive the tree.
+         * @param bufsize Basket size of the branch
+         * @param splitlevel Split level of the branch
+         */
         template<typename T>
-            void addCollection(const std::string& name, std::vector<T*>* collection ){
-                branches_[name] = tree_->Branch(name.c_str(),&collection);};
+            void addCollection(const std::string& name, std::vector<T*>* collection, 
+                    int bufsize = 32000, int splitlevel = 99) {
+                if (branches_.find(name) != branches_.end()) return;
+                branches_[name] = tree_->Branch(name.c_str(), collection, bufsize, getSplitLevel(name, splitlevel));
+            };
+
+        /**
+         * Set the split level used for the collections added to the event.
+         * A pattern set later takes precedence over the earlier ones, as 
+         * for the branch profiles of the Process.
+         *
+         * @param pattern Wildcard pattern matching the collection names
+         * @param splitlevel Split level
+         */
+        void setSplitLevel(const std::string& pattern, int splitlevel) { 
+            split_levels_.push_back(std::make_pair(pattern, splitlevel)); 
+        }
+
+        /**
+         * Get the split level of a collection. 
+         *
+         * @param name Name of the collection
+         * @param splitlevel Split level used if no pattern matches the name
+         *
+         * @return The split level of the last pattern matching the name
+         */
+        int getSplitLevel(const std::string& name, int splitlevel) const;
 
         /** 
          * @param name Name of the collection
@@ -115,7 +151,7 @@ class Event : public IEvent {
          *
          * @param The current entry. 
          */
-        void setEntry(const int entry) { entry_ = entry; }; 
+        void setEntry(const Long64_t entry) { entry_ = entry; }; 
 
     private: 
 
@@ -134,8 +170,11 @@ class Event : public IEvent {
         /** Container will all branches. */
         std::map<std::string, TBranch*> branches_; 
 
+        /** Split levels requested for the collections, by name pattern in the order they were set. */
+        std::vector<std::pair<std::string, int> > split_levels_;
+
         /** The current entry. */
-        int entry_{0};  
+        Long64_t entry_{0};  
 
 }; // Event
 
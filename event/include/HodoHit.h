@@ -25,6 +25,17 @@ public:
     
     /** Destructor */
     ~HodoHit(){ Clear(); };
+
+    /** Reset the hit object. */
+    void Clear(Option_t* option="") {
+        TObject::Clear();
+        index_x_ = -9999;
+        index_y_ = -9999;
+        layer_ = -9999;
+        hole_ = -9999;
+        energy_ = -9999;
+        time_ = 0;
+    };
     
     /**
      * Set the energy of the hit in GeV.
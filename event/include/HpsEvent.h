@@ -3,8 +3,12 @@
 
 #include "IEvent.h"
 #include "TClonesArray.h"
+#include "TBranch.h"
 #include "TTree.h"
 
+#include <map>
+#include <string>
+
 
 class HpsEvent : public IEvent {
 
@@ -14,9 +18,53 @@ class HpsEvent : public IEvent {
   void addCollection(const std::string name, TClonesArray* collection);
   void setTree(TTree* tree);
   virtual TTree* getTree(){return tree_;}
+
+  /**
+   * Set the entry of the input tree held by the event. The lazy 
+   * branches are read again the first time they are requested.
+   *
+   * @param entry Entry in the input tree
+   */
+  void setEntry(Long64_t entry);
+
+  /** Get the entry of the input tree held by the event. */
+  Long64_t getEntry() const { return entry_; }
+
+  /**
+   * Mark a branch as lazy.  The branch is disabled in the input tree, 
+   * so that it isn't read with the rest of the event, and is read 
+   * only when loadBranch is called.
+   *
+   * @param name Name of the branch
+   * @return False if the branch doesn't exist in the tree
+   */
+  bool addLazyBranch(const std::string& name);
+
+  /**
+   * Read a lazy branch for the current entry, if it hasn't been 
+   * read yet. Branches that aren't lazy are always available.
+   *
+   * @param name Name of the branch
+   * @return False if the branch couldn't be read
+   */
+  virtual bool loadBranch(const std::string& name);
+
+  /** Check if the event has lazy branches. */
+  bool hasLazyBranches() const { return !lazyBranches_.empty(); }
  
  private:
-  TTree* tree_;
+  /**
+   * @struct LazyBranch
+   * @brief A lazy branch and the last entry read from it.
+   */
+  struct LazyBranch {
+    TBranch* branch_{nullptr};
+    Long64_t entry_{-1};
+  };
+
+  TTree* tree_{nullptr};
+  Long64_t entry_{-1};
+  std::map<std::string, LazyBranch> lazyBranches_;
 };
 
 #endif
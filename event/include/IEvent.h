@@ -10,6 +10,16 @@ class IEvent {
   virtual ~IEvent(){};
 
   virtual void add(const std::string name, TObject* object) = 0;
+
+  /**
+   * Make sure a collection is read for the current event.  Events that 
+   * read their collections lazily fetch them the first time this is 
+   * called for the event.
+   *
+   * @param name Name of the collection
+   * @return False if the collection couldn't be read
+   */
+  virtual bool loadBranch(const std::string& name) { return true; }
   
 };
 
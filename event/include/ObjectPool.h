@@ -0,0 +1,84 @@
+/**
+ * @file ObjectPool.h
+ * @brief Pool of event objects recycled from one event to the next.
+ */
+
+#ifndef _OBJECT_POOL_H_
+#define _OBJECT_POOL_H_
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <cstddef>
+#include <vector>
+
+//----------//
+//   ROOT   //
+//----------//
+#include <TObject.h>
+
+/**
+ * @class ObjectPool
+ * @brief Owns the objects of a given type built for an event.  The objects
+ *        are handed out by acquire and all given back at once by reset, so
+ *        the objects of an event are reused by the following ones instead
+ *        of being deleted and allocated again.  The type needs a Clear
+ *        method restoring the state of a newly constructed object.
+ */
+template <class T>
+class ObjectPool {
+
+    public:
+
+        /** Constructor */
+        ObjectPool() {};
+
+        /** Destructor.  Deletes all the objects of the pool. */
+        ~ObjectPool() {
+            for (auto object : objects_) delete object;
+        };
+
+        ObjectPool(const ObjectPool&) = delete;
+        ObjectPool& operator=(const ObjectPool&) = delete;
+
+        /**
+         * Get an object from the pool, creating one if all of them are in use.
+         *
+         * @return An object in the state of a newly constructed one.
+         */
+        T* acquire() {
+            if (used_ == objects_.size()) {
+                objects_.push_back(new T());
+                return objects_[used_++];
+            }
+            T* object = objects_[used_++];
+            object->Clear();
+            // A recycled object gets a new unique ID when referenced again
+            object->ResetBit(TObject::kIsReferenced);
+            object->SetUniqueID(0);
+            return object;
+        };
+
+        /**
+         * Give back all the objects to the pool.  They are cleared when
+         * acquired again, so they can still be written until then.
+         */
+        void reset() { used_ = 0; };
+
+        /** @return The number of objects in use. */
+        std::size_t size() const { return used_; };
+
+        /** @return The number of objects owned by the pool. */
+        std::size_t capacity() const { return objects_.size(); };
+
+    private:
+
+        /** All the objects owned by the pool. The first used_ are in use. */
+        std::vector<T*> objects_;
+
+        /** The number of objects in use. */
+        std::size_t used_{0};
+
+}; // ObjectPool
+
+#endif // _OBJECT_POOL_H_
@@ -29,7 +29,7 @@ class RawSvtHit : public TObject {
         virtual ~RawSvtHit();
 
         /** Reset the Hit object. */
-        void Clear();
+        void Clear(Option_t* option="");
 
         /** Set the fit multi */
         void setFitN(int fitN);
@@ -29,6 +29,8 @@ namespace TRACKINFO {
     enum STRATEGY  {MATCH = 0, S345, S456, S123C4, S123C5, GBL};
 }
 
+class TrackerHit;
+
 class Track : public TObject {
 
     public:
@@ -48,6 +50,37 @@ class Track : public TObject {
          * @param hit : A TrackerHit object
          */
         void addHit(TObject* hit); 
+
+        /**
+         * Add a hit along with its index in the hit collection of the event.
+         *
+         * @param hit : A TrackerHit object
+         * @param index : Index of the hit in its collection
+         * @param ref : If false, only the index is stored and the hit isn't
+         *              added to the reference array
+         */
+        void addHit(TObject* hit, int index, bool ref = true); 
+
+        /** 
+         * @return The indices of the hits in the hit collection of the event.
+         *         Empty for tracks written before the indices were stored.
+         */
+        const std::vector<int>& getHitIndices() const { return hit_indices_; };
+
+        /** @return The number of hits reachable with getHit. */
+        int getNHitLinks() const;
+
+        /**
+         * Get a hit of the track.  If the hit collection is given and the
+         * track stores the hit indices, the hit is taken from the collection.
+         * Otherwise it's resolved through the reference array, i.e. for
+         * files written before the indices were stored.
+         *
+         * @param ihit : Index of the hit on the track
+         * @param hits : The hit collection of the same event the indices refer to
+         * @return The hit, null if it can't be found
+         */
+        TrackerHit* getHit(int ihit, const std::vector<TrackerHit*>* hits = nullptr) const;
         
         /**
          * Set the reference to a truth object
@@ -347,6 +380,9 @@ class Track : public TObject {
         /** Array used to store the isolation variables for each of the sensor layers. Updated to 2019 geometry. */
         double isolation_[14];
 
+        /** Indices of the 3D hits in the hit collection of the event. */
+        std::vector<int> hit_indices_;
+
         /** The number of 3D hits associated with this track. */
         int n_hits_{0}; 
 
@@ -440,7 +476,7 @@ class Track : public TObject {
         /** Reference to MC Particle. */
         TRef mcp_link_;
         
-        ClassDef(Track, 1);
+        ClassDef(Track, 2);
 }; // Track
 
 #endif // __TRACK_H__
@@ -11,6 +11,7 @@
 //   C++ StdLib   //
 //----------------//
 #include <iostream>
+#include <vector>
 
 //----------//
 //   ROOT   //
@@ -19,6 +20,8 @@
 #include <TClonesArray.h>
 #include <TRefArray.h>
 
+class RawSvtHit;
+
 class TrackerHit : public TObject { 
 
     public: 
@@ -117,6 +120,42 @@ class TrackerHit : public TObject {
             raw_hits_->Add(rawhit);
         }
 
+        /**
+         * Add a raw hit along with its index in the raw hit collection of 
+         * the event.
+         *
+         * @param rawhit : A RawSvtHit object
+         * @param index : Index of the raw hit in its collection
+         * @param ref : If false, only the index is stored and the raw hit 
+         *              isn't added to the reference array
+         */
+        void addRawHit(TObject* rawhit, int index, bool ref = true) {
+            ++n_rawhits_;
+            raw_hit_indices_.push_back(index);
+            if (ref) raw_hits_->Add(rawhit);
+        }
+
+        /** 
+         * @return The indices of the raw hits in the raw hit collection of 
+         *         the event.  Empty for hits written before they were stored.
+         */
+        const std::vector<int>& getRawHitIndices() const { return raw_hit_indices_; };
+
+        /** @return The number of raw hits reachable with getRawHit. */
+        int getNRawHitLinks() const;
+
+        /**
+         * Get a raw hit of the hit.  If the raw hit collection is given and
+         * the hit stores the raw hit indices, the raw hit is taken from the
+         * collection.  Otherwise it's resolved through the reference array.
+         *
+         * @param irawhit : Index of the raw hit on the hit
+         * @param rawhits : The raw hit collection of the same event the 
+         *                  indices refer to
+         * @return The raw hit, null if it can't be found
+         */
+        RawSvtHit* getRawHit(int irawhit, const std::vector<RawSvtHit*>* rawhits = nullptr) const;
+
         //TODO: I use this to get the shared hits. Not sure if useful. 
         /** LCIO id */
         void setID(const int id) {id_=id;};
@@ -126,7 +165,7 @@ class TrackerHit : public TObject {
         /** LCIO IDs of related MC Particles */
         std::vector<int> getMCPartIDs() const {return mcPartIDs_;};
 
-        ClassDef(TrackerHit, 1);	
+        ClassDef(TrackerHit, 2);	
 
     private:
 
@@ -159,6 +198,9 @@ class TrackerHit : public TObject {
         /** The raw hits */
         TRefArray* raw_hits_{new TRefArray{}};
 
+        /** Indices of the raw hits in the raw hit collection of the event. */
+        std::vector<int> raw_hit_indices_;
+
         /** Layer (Axial + Stereo). 1-6 in 2015/2016 geometry, 0-7 in 2019 geometry */
         int layer_{-999};
 
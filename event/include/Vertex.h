@@ -18,6 +18,8 @@
 
 //TODO make float/doubles accordingly.
 
+class Particle;
+
 class Vertex : public TObject {
 
     public:
@@ -39,6 +41,39 @@ class Vertex : public TObject {
 
         void addParticle(TObject* part);
 
+        /**
+         * Add a particle along with its index in the particle collection of
+         * the event.
+         *
+         * @param part : A Particle object
+         * @param index : Index of the particle in its collection
+         * @param ref : If false, only the index is stored and the particle 
+         *              isn't added to the reference array
+         */
+        void addParticle(TObject* part, int index, bool ref = true);
+
+        /** 
+         * @return The indices of the particles in the particle collection of
+         *         the event.  Empty for vertices written before they were stored.
+         */
+        const std::vector<int>& getParticleIndices() const { return part_indices_; };
+
+        /** @return The number of particles reachable with getParticle. */
+        int getNParticleLinks() const;
+
+        /**
+         * Get a particle of the vertex.  If the particle collection is given
+         * and the vertex stores the particle indices, the particle is taken
+         * from the collection.  Otherwise it's resolved through the 
+         * reference array.
+         *
+         * @param ipart : Index of the particle on the vertex
+         * @param parts : The particle collection of the same event the 
+         *                indices refer to
+         * @return The particle, null if it can't be found
+         */
+        Particle* getParticle(int ipart, const std::vector<Particle*>* parts = nullptr) const;
+
         //TODO unify
         /** Set the chi2 */
         void setChi2(const double chi2) {chi2_ = chi2;}
@@ -147,7 +182,7 @@ class Vertex : public TObject {
         /** Get the Target Constrained Y */
         double getTgtConstrY() const {return parameters_[20];}
         
-        ClassDef(Vertex,1);
+        ClassDef(Vertex,2);
 
     private:
 
@@ -163,6 +198,7 @@ class Vertex : public TObject {
         int id_;
         std::string type_{""};
         TRefArray* parts_{new TRefArray()};
+        std::vector<int> part_indices_;
         int n_parts_{0};
         std::vector<float> parameters_;
 
@@ -15,7 +15,8 @@ CalCluster::CalCluster()
 
 //TODO Fix the relation between particles->CalClusters (same as tracks)
 CalCluster::~CalCluster() {
-    Clear();
+    // The hits array is shared by the copies of a cluster, so it is not
+    // cleared here
     //delete hits_;   
 }
 
@@ -23,8 +24,14 @@ CalCluster::~CalCluster() {
 void CalCluster::Clear(Option_t* /*option*/) {
     TObject::Clear();
     //hits_->Delete();
+    hits_->Clear();
     seed_hit_ = nullptr; 
     n_hits_ = 0;
+    x_ = -9999;
+    y_ = -9999;
+    z_ = -9999;
+    energy_ = -9999;
+    time_ = -9999;
 }
 
 void CalCluster::setPosition(const float* position) {
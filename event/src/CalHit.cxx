@@ -18,6 +18,10 @@ CalHit::~CalHit() {
 
 void CalHit::Clear(Option_t* /* options */) {
     TObject::Clear(); 
+    index_x_ = -9999;
+    index_y_ = -9999;
+    energy_ = -9999;
+    time_ = 0;
 }
 
 void CalHit::setCrystalIndices(int index_x, int index_y) {
@@ -7,6 +7,8 @@
 
 #include "Event.h"
 
+#include <fnmatch.h>
+
 /*~~~~~~~~~~*/
 /*   LCIO   */
 /*~~~~~~~~~~*/
@@ -42,18 +44,26 @@ void Event::add(const std::string name, TObject* object) {
     object->Copy(*cp); 
 }
 
-void Event::addCollection(const std::string name, TClonesArray* collection) {   
+void Event::addCollection(const std::string name, TClonesArray* collection, int bufsize, int splitlevel) {   
 
     // Check if the collection has been added
     if (objects_.find(name) != objects_.end()) return; 
 
     // Add a branch with the given name to the event tree.
-    branches_[name] = tree_->Branch(name.c_str(), collection, 1000000, 3); 
+    branches_[name] = tree_->Branch(name.c_str(), collection, bufsize, getSplitLevel(name, splitlevel)); 
 
     // Keep track of which collections were added to the event
     objects_[name] = collection;  
 }
 
+int Event::getSplitLevel(const std::string& name, int splitlevel) const {
+
+    for (auto& split : split_levels_) { 
+        if (fnmatch(split.first.c_str(), name.c_str(), 0) == 0) splitlevel = split.second; 
+    }
+    return splitlevel; 
+}
+
 TClonesArray* Event::getCollection(const std::string name) { 
     
     // Check if the collection already exist
@@ -15,8 +15,13 @@ HodoCluster::~HodoCluster() {
 
 void HodoCluster::Clear(Option_t* /*option*/) {
     TObject::Clear();
-    hits_->Delete();
+    hits_->Clear();
     n_hits_ = 0;
+    index_x_ = -9999;
+    index_y_ = -9999;
+    layer_ = -9999;
+    energy_ = -9999;
+    time_ = -9999;
 }
 
 void HodoCluster::addHit(TObject* hit) {
@@ -4,3 +4,37 @@ HpsEvent::HpsEvent() {}
 
 void HpsEvent::addCollection(const std::string name, TClonesArray* collection) {}
 void HpsEvent::setTree(TTree* tree) {tree_ = tree;}
+
+void HpsEvent::setEntry(Long64_t entry) {entry_ = entry;}
+
+bool HpsEvent::addLazyBranch(const std::string& name) {
+  if (!tree_)
+    return false;
+
+  TBranch* branch = tree_->GetBranch(name.c_str());
+  if (!branch)
+    return false;
+
+  // Disabled branches are skipped by TTree::GetEntry
+  UInt_t found = 0;
+  tree_->SetBranchStatus(name.c_str(), 0, &found);
+  tree_->SetBranchStatus((name + ".*").c_str(), 0, &found);
+  lazyBranches_[name].branch_ = branch;
+  return true;
+}
+
+bool HpsEvent::loadBranch(const std::string& name) {
+  auto it = lazyBranches_.find(name);
+  if (it == lazyBranches_.end())
+    return true;
+
+  LazyBranch& lazy = it->second;
+  if (lazy.entry_ == entry_)
+    return true;
+
+  // Read the branch and its sub-branches even though they are disabled
+  if (lazy.branch_->GetEntry(tree_->LoadTree(entry_), 1) < 0)
+    return false;
+  lazy.entry_ = entry_;
+  return true;
+}
@@ -19,8 +19,26 @@ MCParticle::~MCParticle() {
 
 void MCParticle::Clear(Option_t* /* option */) {
     TObject::Clear();
-    daughters_->Delete();     
+    daughters_->Clear();     
     n_daughters_ = 0;    
+    id_ = -9999;
+    charge_ = -9999;
+    pdg_ = -9999;
+    momPDG_ = -9999;
+    gen_ = -9999;
+    sim_ = -9999;
+    px_ = -9999;
+    py_ = -9999;
+    pz_ = -9999;
+    vtx_x_ = -9999;
+    vtx_y_ = -9999;
+    vtx_z_ = -9999;
+    ep_x_ = -9999;
+    ep_y_ = -9999;
+    ep_z_ = -9999;
+    energy_ = -9999;
+    mass_ = -9999;
+    time_ = -9999;
 }
 
 void MCParticle::addDaughter(MCParticle* particle) {
@@ -8,6 +8,21 @@
 
 ClassImp(Particle)
 
+namespace { 
+
+    /** Track a cleared particle is reset to. It is never filled. */
+    const Track& emptyTrack() { 
+        static const Track track; 
+        return track; 
+    }
+
+    /** Cluster a cleared particle is reset to. It is never filled. */
+    const CalCluster& emptyCluster() { 
+        static const CalCluster cluster; 
+        return cluster; 
+    }
+}
+
 Particle::Particle()
     : TObject() { 
 }
@@ -18,6 +33,23 @@ Particle::~Particle() {
 
 void Particle::Clear(Option_t* /* option */) {
     TObject::Clear();
+    // The track and cluster share their arrays with the objects they were
+    // copied from, which may be in use again, so they are reset to empty
+    // ones instead of being cleared
+    track_ = emptyTrack();
+    cluster_ = emptyCluster();
+    charge_ = -9999;
+    type_ = -9999;
+    pdg_ = -9999;
+    goodness_pid_ = -9999;
+    px_ = -9999;
+    px_corr_ = -9999;
+    py_ = -9999;
+    py_corr_ = -9999;
+    pz_ = -9999;
+    pz_corr_ = -9999;
+    energy_ = -9999;
+    mass_ = -9999;
 }
 
 void Particle::setMomentum(const double* momentum) {
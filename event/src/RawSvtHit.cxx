@@ -16,8 +16,20 @@ RawSvtHit::~RawSvtHit() {
     Clear(); 
 }
 
-void RawSvtHit::Clear() { 
+void RawSvtHit::Clear(Option_t* /* option */) { 
     TObject::Clear(); 
+    for (int i = 0; i < 6; ++i) adcs_[i] = -999;
+    system_ = -999;
+    barrel_ = -999;
+    layer_ = -999;
+    module_ = -999;
+    sensor_ = -999;
+    side_ = -999;
+    strip_ = -999;
+    fitN_ = 0;
+    for (int ifit = 0; ifit < 2; ++ifit) {
+        for (int i = 0; i < 5; ++i) fit_[ifit][i] = -999.9;
+    }
 }
 
 void RawSvtHit::setFitN(int fitN) {
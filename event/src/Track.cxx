@@ -5,6 +5,7 @@
  */
 
 #include "Track.h"
+#include "TrackerHit.h"
 
 ClassImp(Track)
 
@@ -14,7 +15,8 @@ Track::Track()
 
 //TODO Fix particle->track->tracker hits relation. If Track is object of Particle then tracker_hits in on the stack and delete make it crash?
 Track::~Track() {
-    Clear();
+    // The hits array is shared by the copies of a track, so it is not
+    // cleared here
     //delete tracker_hits_;
 }
 
@@ -24,8 +26,37 @@ void Track::Clear(Option_t* /* option */) {
     TObject::Clear();
     //if (tracker_hits_) 
     //   tracker_hits_->Delete();
+    tracker_hits_->Clear();
+    hit_indices_.clear();
+    particle_ = nullptr;
     memset(isolation_, 0, sizeof(isolation_)); 
     n_hits_ = 0; 
+    track_volume_ = -999;
+    type_ = -999;
+    cov_.clear();
+    d0_ = -999;
+    phi0_ = -999;
+    omega_ = -999;
+    tan_lambda_ = -999;
+    z0_ = -999;
+    chi2_ = -999;
+    ndf_ = 0.;
+    track_time_ = -999;
+    x_at_ecal_ = -999;
+    y_at_ecal_ = -999;
+    z_at_ecal_ = -999;
+    memset(lambda_kinks_, 0, sizeof(lambda_kinks_));
+    memset(phi_kinks_, 0, sizeof(phi_kinks_));
+    px_ = -9999;
+    py_ = -9999;
+    pz_ = -9999;
+    id_ = 0;
+    charge_ = 0;
+    nShared_ = 0;
+    SharedLy0_ = false;
+    SharedLy1_ = false;
+    truth_link_ = nullptr;
+    mcp_link_ = nullptr;
 }
 
 void Track::setTrackParameters(double d0, double phi0, double omega,
@@ -81,6 +112,25 @@ void Track::addHit(TObject* hit) {
     tracker_hits_->Add(hit); 
 }
 
+void Track::addHit(TObject* hit, int index, bool ref) {
+    ++n_hits_; 
+    hit_indices_.push_back(index);
+    if (ref) tracker_hits_->Add(hit); 
+}
+
+int Track::getNHitLinks() const { 
+    if (!hit_indices_.empty()) return hit_indices_.size();
+    return tracker_hits_->GetEntriesFast();
+}
+
+TrackerHit* Track::getHit(int ihit, const std::vector<TrackerHit*>* hits) const { 
+    if (hits && ihit < (int) hit_indices_.size()) {
+        int index = hit_indices_[ihit];
+        return index >= 0 && index < (int) hits->size() ? (*hits)[index] : nullptr;
+    }
+    return static_cast<TrackerHit*>(tracker_hits_->At(ihit));
+}
+
 void Track::Print (Option_t *option) const {
     printf("d0     Phi     Omega     TanLambda     Z0     time     chi2\n");
     printf("% 6.4f  % 6.4f  % 6.4f  % 6.4f  % 6.4f  % 6.4f  % 6.4f\n",d0_,phi0_,omega_,tan_lambda_,z0_,track_time_,chi2_);
@@ -5,6 +5,7 @@
  */
 
 #include "TrackerHit.h"
+#include "RawSvtHit.h"
 
 ClassImp(TrackerHit)
 
@@ -13,11 +14,33 @@ TrackerHit::TrackerHit()
     }
 
 TrackerHit::~TrackerHit() { 
-    Clear(); 
+    // The hit arrays are shared by the copies of a hit, so they are not
+    // cleared here
 }
 
 void TrackerHit::Clear(Option_t* /* options */) { 
     TObject::Clear(); 
+    raw_hits_->Clear();
+    raw_hit_indices_.clear();
+    tracks_->Clear();
+    n_rawhits_ = 0;
+    x_ = -999;
+    y_ = -999;
+    z_ = -999;
+    cxx_ = 0;
+    cxy_ = 0;
+    cxz_ = 0;
+    cyy_ = 0;
+    cyz_ = 0;
+    czz_ = 0;
+    time_ = -999;
+    charge_ = -999;
+    layer_ = -999;
+    volume_ = -999;
+    rawcharge_ = -999;
+    shared_ = -999;
+    id_ = -999;
+    mcPartIDs_.clear();
 }
 
 void TrackerHit::setPosition(const double* position, bool rotate, int type) {
@@ -79,3 +102,16 @@ void TrackerHit::setCovarianceMatrix(const std::vector<float> covariance_matrix)
 std::vector<double> TrackerHit::getCovarianceMatrix() const { 
     return { cxx_, cxy_, cxz_, cyy_, cyz_, czz_ }; 
 }
+
+int TrackerHit::getNRawHitLinks() const { 
+    if (!raw_hit_indices_.empty()) return raw_hit_indices_.size();
+    return raw_hits_->GetEntriesFast();
+}
+
+RawSvtHit* TrackerHit::getRawHit(int irawhit, const std::vector<RawSvtHit*>* rawhits) const { 
+    if (rawhits && irawhit < (int) raw_hit_indices_.size()) {
+        int index = raw_hit_indices_[irawhit];
+        return index >= 0 && index < (int) rawhits->size() ? (*rawhits)[index] : nullptr;
+    }
+    return static_cast<RawSvtHit*>(raw_hits_->At(irawhit));
+}
@@ -6,6 +6,7 @@
  */
 
 #include "Vertex.h"
+#include "Particle.h"
 #include <iostream>
 
 ClassImp(Vertex)
@@ -22,7 +23,21 @@ void Vertex::Clear(Option_t *option) {
     pos_.Clear();
     p1_.Clear();
     p2_.Clear();
-    parts_->Delete();
+    pos_.SetXYZ(0, 0, 0);
+    p1_.SetXYZ(0, 0, 0);
+    p2_.SetXYZ(0, 0, 0);
+    p_.SetXYZ(0, 0, 0);
+    parts_->Clear();
+    part_indices_.clear();
+    n_parts_ = 0;
+    chi2_ = -999;
+    ndf_ = -999;
+    invM_ = -999;
+    invMerr_ = -999;
+    covariance_.clear();
+    probability_ = -999;
+    type_ = "";
+    parameters_.clear();
     TObject::Clear();
 }
 
@@ -32,6 +47,28 @@ void Vertex::addParticle(TObject* part)
     parts_->Add(part);
 }
 
+void Vertex::addParticle(TObject* part, int index, bool ref)
+{ 
+    n_parts_++;
+    part_indices_.push_back(index);
+    if (ref) parts_->Add(part);
+}
+
+int Vertex::getNParticleLinks() const
+{ 
+    if (!part_indices_.empty()) return part_indices_.size();
+    return parts_->GetEntriesFast();
+}
+
+Particle* Vertex::getParticle(int ipart, const std::vector<Particle*>* parts) const
+{ 
+    if (parts && ipart < (int) part_indices_.size()) {
+        int index = part_indices_[ipart];
+        return index >= 0 && index < (int) parts->size() ? (*parts)[index] : nullptr;
+    }
+    return static_cast<Particle*>(parts_->At(ipart));
+}
+
 void Vertex::setCovariance( const std::vector<float>& vec){ 
     covariance_ = vec;
 }
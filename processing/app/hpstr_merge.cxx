@@ -0,0 +1,92 @@
+/**
+ *  @file   hpstr_merge.cxx
+ *  @brief  App used to merge the ROOT output files of hpstr jobs.
+ */
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept> 
+#include <string>
+#include <thread>
+#include <vector>
+
+//-----------//
+//   hpstr   //
+//-----------//
+#include "OutputMerger.h"
+
+using namespace std; 
+
+void displayUsage(); 
+
+int main(int argc, char **argv) { 
+
+    int threads = std::max((int)std::thread::hardware_concurrency(), 1);
+    int fanin = 16;
+    std::string output;
+    std::vector<std::string> inputs;
+
+    for (int iarg = 1; iarg < argc; ++iarg) {
+        std::string arg(argv[iarg]);
+        if ((arg == "-j" || arg == "-f" || arg == "-l") && iarg + 1 == argc) {
+            displayUsage();
+            return EXIT_FAILURE;
+        }
+        if (arg == "-h" || arg == "--help") {
+            displayUsage();
+            return EXIT_SUCCESS;
+        } else if (arg == "-j") {
+            threads = atoi(argv[++iarg]);
+        } else if (arg == "-f") {
+            fanin = atoi(argv[++iarg]);
+        } else if (arg == "-l") {
+            // Read the input files from a list, one per line
+            std::ifstream list(argv[++iarg]);
+            if (!list) {
+                std::cerr << "Error! [Unable to open file list " << argv[iarg] << "]" << std::endl;
+                return EXIT_FAILURE;
+            }
+            std::string line;
+            while (std::getline(list, line)) {
+                if (!line.empty()) inputs.push_back(line);
+            }
+        } else if (output.empty()) {
+            output = arg;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+
+    if (output.empty() || inputs.empty()) {
+        displayUsage();
+        return EXIT_FAILURE;
+    }
+
+    try {
+
+        std::cout << "---- [ hpstr-merge ]: Merging " << inputs.size() << " files into " << output 
+            << " using " << threads << " threads --------" << std::endl;
+
+        OutputMerger merger(threads, fanin);
+        merger.merge(inputs, output);
+
+        std::cout << "---- [ hpstr-merge ]: Merge complete --------" << std::endl;
+
+    } catch (exception& e) { 
+        std::cerr << "Error! [" << e.what() << "] \n";
+        std::cerr << "Program aborted. " << std::endl;
+        return EXIT_FAILURE;
+    } 
+
+    return EXIT_SUCCESS;
+}
+
+void displayUsage() {
+    printf("Usage: hpstr-merge [-j threads] [-f fan-in] [-l file_list] output.root [input.root ...]\n");
+}
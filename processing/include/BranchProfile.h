@@ -0,0 +1,41 @@
+/**
+ * @file BranchProfile.h
+ * @brief Storage settings applied to the output branches of the event tree.
+ */
+
+#ifndef __BRANCH_PROFILE_H__
+#define __BRANCH_PROFILE_H__
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <string>
+
+/**
+ * @struct BranchProfile
+ * @brief Compression and basket settings of the output branches whose name 
+ *        matches a wildcard pattern.  Negative values keep the defaults.
+ */
+struct BranchProfile {
+
+    /** Wildcard pattern matched against the top level branch names, i.e. "SVT*". */
+    std::string branches_;
+
+    /** Compression algorithm: ZLIB, LZMA, LZ4 or ZSTD.  Empty keeps the file setting. */
+    std::string algorithm_;
+
+    /** Compression level. */
+    int level_{-1};
+
+    /** Basket size in bytes. */
+    int basket_size_{-1};
+
+    /** 
+     * Split level.  Only applied to the branches created through 
+     * Processor::addBranch or Event::addCollection, since the split level 
+     * of a branch can't be changed once it has been created.
+     */
+    int split_level_{-1};
+};
+
+#endif // __BRANCH_PROFILE_H__
@@ -0,0 +1,179 @@
+/**
+ * @file ColumnarWriter.h
+ * @brief Class writing flat, struct-of-arrays copies of the collections
+ *        of the event tree.
+ */
+
+#ifndef __COLUMNAR_WRITER_H__
+#define __COLUMNAR_WRITER_H__
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//----------//
+//   ROOT   //
+//----------//
+#include <TBranch.h>
+#include <TObject.h>
+#include <TRefArray.h>
+#include <TTree.h>
+
+/**
+ * @class ColumnarWriter
+ * @brief Adds flat columns next to the object branches of the event tree.
+ *
+ * For a collection GBLTracks of type std::vector<Track*>, the branches
+ *
+ *   nGBLTracks/I
+ *   GBLTracks_d0[nGBLTracks]/D
+ *   GBLTracks_cov[nGBLTracks][15]/D
+ *   ...
+ *
+ * are written with one value per object.  References to other objects are
+ * written as indices in the collection holding them: a single reference
+ * as GBLTracks_<link>[nGBLTracks]/I, a TRefArray as the jagged triplet
+ * GBLTracks_<link>Begin[nGBLTracks]/I, GBLTracks_<link>Count[nGBLTracks]/I
+ * and GBLTracks_<link>[nGBLTracks_<link>]/I.  The index is -1 if the
+ * referenced object isn't in a columnar collection of the same event.
+ * Where the objects store the indices of the referenced objects, these
+ * are written as they are and the TRefArray is only read for inputs
+ * without them.
+ * Only std::vector branches of Track, TrackerHit, RawSvtHit, CalHit,
+ * CalCluster, Vertex, Particle and MCParticle pointers are supported.
+ */
+class ColumnarWriter {
+
+    public:
+
+        /**
+         * Constructor.  Adds the columns of the supported collections of
+         * the tree.  Needs to be called after the processors created
+         * their branches.
+         *
+         * @param tree The event tree
+         * @param collections Names of the collections written.  All the
+         *     supported collections are written if empty.
+         */
+        ColumnarWriter(TTree* tree, const std::vector<std::string>& collections);
+
+        /** Fill the columns from the current objects.  Called before the tree is filled. */
+        void fill();
+
+        /** @return The number of collections written. */
+        unsigned int getNumberOfCollections() const { return collections_.size(); };
+
+    private:
+
+        /**
+         * @struct Column
+         * @brief A fixed number of values per object.
+         */
+        struct Column {
+            std::string name_;
+            int width_{1};
+            bool integer_{false};
+            std::function<void(TObject*, double*)> get_;
+            std::vector<Double_t> doubles_;
+            std::vector<Int_t> ints_;
+            TBranch* branch_{nullptr};
+        };
+
+        /**
+         * @struct Link
+         * @brief References from each object to the objects of other collections.
+         */
+        struct Link {
+            std::string name_;
+            bool jagged_{false};
+            std::function<void(TObject*, std::vector<TObject*>&)> targets_;
+            std::function<const std::vector<int>*(TObject*)> stored_;
+            Int_t total_{0};
+            std::vector<Int_t> begin_;
+            std::vector<Int_t> count_;
+            std::vector<Int_t> index_;
+            TBranch* begin_branch_{nullptr};
+            TBranch* count_branch_{nullptr};
+            TBranch* index_branch_{nullptr};
+        };
+
+        /**
+         * @struct Collection
+         * @brief The columns of a collection.
+         */
+        struct Collection {
+            std::string name_;
+            std::function<std::size_t()> size_;
+            std::function<TObject*(std::size_t)> at_;
+            Int_t n_{0};
+            std::vector<Column> columns_;
+            std::vector<Link> links_;
+        };
+
+        /** Add a column with one value per object. */
+        template <class T>
+        void addColumn(Collection& collection, const std::string& name,
+                std::function<double(T*)> get, bool integer = false);
+
+        /** Add a column with width values per object. */
+        template <class T>
+        void addColumns(Collection& collection, const std::string& name, int width,
+                std::function<void(T*, double*)> get, bool integer = false);
+
+        /** Add the index of a single referenced object. */
+        template <class T>
+        void addLink(Collection& collection, const std::string& name,
+                std::function<TObject*(T*)> target);
+
+        /** Add the indices of the objects of a TRefArray. */
+        template <class T>
+        void addLinks(Collection& collection, const std::string& name,
+                std::function<TRefArray*(T*)> targets);
+
+        /**
+         * Add the indices stored in the objects, taken from the TRefArray
+         * when none are stored.
+         */
+        template <class T>
+        void addLinks(Collection& collection, const std::string& name,
+                std::function<TRefArray*(T*)> targets,
+                std::function<const std::vector<int>&(T*)> indices);
+
+        /** Add the columns of each supported element type. */
+        void addTrack(Collection& collection);
+        void addTrackerHit(Collection& collection);
+        void addRawSvtHit(Collection& collection);
+        void addCalHit(Collection& collection);
+        void addCalCluster(Collection& collection);
+        void addVertex(Collection& collection);
+        void addParticle(Collection& collection);
+        void addMCParticle(Collection& collection);
+
+        /** Create the branches of a collection. */
+        void makeBranches(Collection& collection);
+
+        /** @return The index of an object in its collection, -1 if not written. */
+        Int_t indexOf(TObject* object) const;
+
+        /** The event tree. */
+        TTree* tree_{nullptr};
+
+        /** The collections written. */
+        std::vector<Collection> collections_;
+
+        /** Index of each object of the current event in its collection. */
+        std::unordered_map<const TObject*, Int_t> indices_;
+
+        /** Buffer of the values of an object. */
+        std::vector<double> values_;
+
+        /** Buffer of the objects referenced by an object. */
+        std::vector<TObject*> targets_;
+
+}; // ColumnarWriter
+
+#endif // __COLUMNAR_WRITER_H__
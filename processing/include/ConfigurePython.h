@@ -58,11 +58,96 @@ class ConfigurePython {
          *  0: LCIO to ROOT
          *  1: ROOT to Histo
          *  2: Histo Analysis
+         *  3: ROOT to Histo on the events of an event list
          * */
         int run_mode_{-1};
 
         /** The maximum number of events to process, if provided in python file. */
-        int event_limit_{-1};
+        long event_limit_{-1};
+
+        /** The event list used in run mode 3. */
+        std::string event_list_;
+
+        /** Write the run/event index of the output files in run mode 0. */
+        bool build_index_{false};
+
+        /** The index of the first event read from each file. */
+        long first_event_{0};
+
+        /** One past the index of the last event read from each file. -1 for no limit. */
+        long last_event_{-1};
+
+        /** The index of the shard processed by the job. */
+        int shard_index_{0};
+
+        /** The number of shards each file is split in. */
+        int n_shards_{1};
+
+        /** The shard mode: contiguous or modulo. */
+        std::string shard_mode_;
+
+        /** The number of threads used to process events in run mode 1. */
+        int threads_{1};
+
+        /** The number of worker processes used to convert files in run mode 0. */
+        int workers_{1};
+
+        /** Produce the timing report. */
+        bool timing_{true};
+
+        /** Number of events between two memory samples.  0 if not profiling. */
+        long memory_profile_{0};
+
+        /** The number of threads running the processors of an event in run mode 0. */
+        int concurrent_processors_{1};
+
+        /** The number of LCIO events decoded ahead in run mode 0. */
+        int read_ahead_{0};
+
+        /** The number of threads compressing the output baskets in run mode 0. */
+        int write_threads_{0};
+
+        /** Uncompressed bytes buffered before flushing the output baskets. */
+        long write_buffer_{30000000};
+
+        /** Auto-flush of the output tree in run mode 0. */
+        long auto_flush_{0};
+
+        /** Storage profiles of the output branches in run mode 0. */
+        std::vector<BranchProfile> branch_profiles_;
+
+        /** Write the flat columns of the output collections in run mode 0. */
+        bool columnar_{false};
+
+        /** Collections written as columns. */
+        std::vector<std::string> columnar_collections_;
+
+        /** Write the passing events to a skim tree in run mode 1. */
+        bool skim_{false};
+
+        /** Branches kept in the skim tree. */
+        std::vector<std::string> skim_branches_;
+
+        /** Read only the input branches used by the processors in run mode 1. */
+        bool active_branches_only_{false};
+
+        /** Input branches to read in addition to the ones used by the processors. */
+        std::vector<std::string> extra_branches_;
+
+        /** Input branches read only when requested by a processor. */
+        std::vector<std::string> lazy_branches_;
+
+        /** Size of the input TTreeCache in bytes. Negative for the ROOT default. */
+        long cache_size_{-1};
+
+        /** Number of entries used to train the input TTreeCache. */
+        int cache_learn_entries_{0};
+
+        /** Input branches added to the TTreeCache. */
+        std::vector<std::string> cache_branches_;
+
+        /** Prefetch the input baskets asynchronously. */
+        bool async_prefetch_{false};
 
         /** List of input files to process in the job, if provided in python file. */
         std::vector<std::string> input_files_;
@@ -86,6 +171,28 @@ class ConfigurePython {
         /** The sequence of EventProcessor objects to be executed in order. */
         std::vector<ProcessorInfo> sequence_;
 
+        /**
+         * @struct WagonInfo
+         * @brief Represents the configuration of a wagon, a processor sequence 
+         *        with its own output files reading the same events as the main sequence.
+         */
+        struct WagonInfo {
+            std::string name_;
+            std::vector<ProcessorInfo> sequence_;
+            std::vector<std::string> output_files_;
+        };
+
+        /** The wagons of the job. */
+        std::vector<WagonInfo> wagons_;
+
+        /**
+         * Read the configuration of a processor sequence.
+         *
+         * @param p_sequence Python list of processors
+         * @return The configurations of the processors, in order
+         */
+        std::vector<ProcessorInfo> readSequence(PyObject* p_sequence);
+
 };
 
 #endif // __CONFIGURE_PYTHON_H__
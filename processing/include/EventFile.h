@@ -7,6 +7,15 @@
 #ifndef __EVENT_FILE_H__
 #define __EVENT_FILE_H__
 
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 //----------//
 //   ROOT   //
 //----------//
@@ -23,7 +32,10 @@
 //-----------//
 //   hpstr   //
 //-----------//
+#include "BranchProfile.h"
+#include "ColumnarWriter.h"
 #include "Event.h"
+#include "EventIndex.h"
 #include "IEventFile.h"
 
 class EventFile : public IEventFile {
@@ -57,6 +69,69 @@ class EventFile : public IEventFile {
          */
         void setupEvent(IEvent* ievent);
 
+        /**
+         * Apply the storage profiles to the branches of the output tree. 
+         * Needs to be called after the branches have been created and 
+         * before the first event is filled.  The split levels need to be 
+         * set in the event before the collections are added.
+         *
+         * @param profiles The branch profiles.  When several profiles match 
+         *     a branch, the last one takes precedence.
+         */
+        void applyBranchProfiles(const std::vector<BranchProfile>& profiles);
+
+        /**
+         * Write flat, struct-of-arrays columns of the collections next to 
+         * their object branches.  Needs to be called after the branches 
+         * have been created and before the first event is filled.
+         *
+         * @param collections Names of the collections written.  All the 
+         *     supported collections are written if empty.
+         */
+        void setupColumnar(const std::vector<std::string>& collections);
+
+        /**
+         * Print the compressed and uncompressed size of each output branch.
+         */
+        void printBranchSizes();
+
+        /**
+         * Select the events read from the input file.  The events with 
+         * index first, first + stride, first + 2*stride, ... below last are 
+         * read, the others are skipped.  Needs to be called before the 
+         * first call to nextEvent.
+         *
+         * @param first Index of the first event
+         * @param last One past the index of the last event.  Negative to read 
+         *     until the end of the file.
+         * @param stride Distance between the selected events
+         */
+        void setEventRange(Long64_t first, Long64_t last, Long64_t stride = 1);
+
+        /**
+         * Record the run and event number of each filled event, and write 
+         * the index next to the output file when the file is closed.
+         *
+         * @param build_index If true, the index is built
+         */
+        void setBuildIndex(bool build_index);
+
+        /** @return The number of events in the input file. */
+        Long64_t getNumberOfEvents();
+
+        /**
+         * Decode the next events in a background thread while the current 
+         * one is being processed.  The events are read by separate LCIO 
+         * readers, each one owning one slot of a bounded queue, and are 
+         * handed over in file order.  A slot is recycled when the next 
+         * event is requested, i.e. after the current event has been filled. 
+         * Needs to be called before the first call to nextEvent.
+         *
+         * @param read_ahead Number of events decoded ahead. 0 reads the 
+         *     events on the calling thread.
+         */
+        void setReadAhead(int read_ahead);
+
         /** 
          * Close the file, writing the tree to disk if creating an output file.
          */
@@ -69,6 +144,27 @@ class EventFile : public IEventFile {
 
     private: 
 
+        /**
+         * @struct ReadSlot
+         * @brief An LCIO reader and the last event it decoded.
+         */
+        struct ReadSlot {
+            IO::LCReader* reader{nullptr};
+            EVENT::LCEvent* event{nullptr};
+            bool ready{false};
+            bool end{false};
+            Long64_t read_index{0};
+        };
+
+        /** Start the background reader thread. */
+        void startReader();
+
+        /** Stop the background reader thread and close its readers. */
+        void stopReader();
+
+        /** Loop of the background reader thread. */
+        void readAhead();
+
         /** The ROOT file to which event data will be written to. */
         TFile* ofile_{nullptr}; 
 
@@ -84,7 +180,56 @@ class EventFile : public IEventFile {
         /** LCIO reader */
         IO::LCReader* lc_reader_{IOIMPL::LCFactory::getInstance()->createLCReader()}; 
 
-        int entry_{0};  
+        /** Name of the output ROOT file. */
+        std::string ofilename_;
+
+        /** Index of the filled events.  Null if not requested. */
+        EventIndex* index_{nullptr};
+
+        /** Writer of the flat columns.  Null if not requested. */
+        ColumnarWriter* columnar_{nullptr};
+
+        /** Number of events handed over so far. */
+        Long64_t entry_{0};  
+
+        /** Index of the first selected input event. */
+        Long64_t first_event_{0};
+
+        /** One past the index of the last selected input event.  Negative for no limit. */
+        Long64_t last_event_{-1};
+
+        /** Distance between the selected input events. */
+        Long64_t stride_{1};
+
+        /** Index of the next event returned by the main reader. */
+        Long64_t read_index_{0};
+
+        /** Name of the input LCIO file. */
+        std::string ifilename_;
+
+        /** Number of events decoded ahead by the reader thread. */
+        int read_ahead_{0};
+
+        /** Queue of events decoded by the reader thread. */
+        std::vector<ReadSlot> slots_;
+
+        /** Slot holding the event currently processed.  -1 before the first event. */
+        int current_slot_{-1};
+
+        /** Background reader thread. */
+        std::thread reader_thread_;
+
+        /** Protects the slots shared with the reader thread. */
+        std::mutex slots_mutex_;
+
+        /** Signals changes of the slots. */
+        std::condition_variable slots_cv_;
+
+        /** Request the reader thread to stop. */
+        bool stop_reader_{false};
+
+        /** Error raised by the reader thread. */
+        std::string reader_error_;
 
 }; // EventFile
 
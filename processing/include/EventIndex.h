@@ -0,0 +1,128 @@
+/**
+ * @file EventIndex.h
+ * @brief Class mapping the run and event numbers of a DST to the entries 
+ *        of its event tree.
+ */
+
+#ifndef __EVENT_INDEX_H__
+#define __EVENT_INDEX_H__
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+//----------//
+//   ROOT   //
+//----------//
+#include "TTree.h"
+
+/**
+ * @class EventIndex
+ * @brief Maps (run, event) to the entry of the HPS_Event tree of a DST. 
+ *
+ * The index is persisted in a sidecar file next to the DST, 
+ * <dst>.index.root, holding an EventIndex tree with the run, event and 
+ * entry of every event, along with the number of entries and the UUID of 
+ * the DST it was built from.
+ */
+class EventIndex {
+
+    public:
+
+        /**
+         * Get the name of the sidecar file of a DST.
+         * @param dst Name of the DST file
+         * @return Name of the index file
+         */
+        static std::string indexFileName(const std::string& dst);
+
+        /**
+         * Load the index of a DST from its sidecar file.  If the sidecar 
+         * doesn't exist or was built from another version of the DST, the 
+         * index is built from the EventHeader branch of the DST and written 
+         * to the sidecar.
+         * @param dst Name of the DST file
+         * @return The index
+         */
+        static EventIndex load(const std::string& dst);
+
+        /**
+         * Add an event to the index.
+         * @param run Run number
+         * @param event Event number
+         * @param entry Entry of the event in the tree
+         */
+        void add(int run, int event, Long64_t entry);
+
+        /**
+         * Build the index from the event headers of a tree. 
+         * @param tree The event tree
+         * @param header Name of the EventHeader branch
+         */
+        void build(TTree* tree, const std::string& header = "EventHeader");
+
+        /**
+         * Find the entry of an event.
+         * @param run Run number
+         * @param event Event number
+         * @return The entry, -1 if the event isn't in the index
+         */
+        Long64_t find(int run, int event) const;
+
+        /** @return The number of events in the index. */
+        size_t size() const { return entries_.size(); }
+
+        /**
+         * Set the DST the index was built from.
+         * @param nentries Number of entries of the HPS_Event tree
+         * @param uuid UUID of the DST file
+         */
+        void setSource(Long64_t nentries, const std::string& uuid) { 
+            nentries_ = nentries; 
+            uuid_ = uuid; 
+        }
+
+        /**
+         * @param nentries Number of entries of the HPS_Event tree
+         * @param uuid UUID of the DST file
+         * @return True if the index was built from this DST
+         */
+        bool matches(Long64_t nentries, const std::string& uuid) const { 
+            return nentries_ == nentries && uuid_ == uuid; 
+        }
+
+        /**
+         * Read the index from a file.
+         * @param filename Name of the index file
+         * @return False if the file couldn't be read
+         */
+        bool read(const std::string& filename);
+
+        /**
+         * Write the index to a file.
+         * @param filename Name of the index file
+         * @return False if the file couldn't be written
+         */
+        bool write(const std::string& filename) const;
+
+    private:
+
+        /** @return The key of an event in the map. */
+        static uint64_t key(int run, int event) { 
+            return (uint64_t(uint32_t(run)) << 32) | uint32_t(event); 
+        }
+
+        /** Map from the (run, event) key to the entry. */
+        std::unordered_map<uint64_t, Long64_t> entries_;
+
+        /** Number of entries of the HPS_Event tree the index was built from, -1 if unknown. */
+        Long64_t nentries_{-1};
+
+        /** UUID of the DST the index was built from. */
+        std::string uuid_;
+};
+
+#endif // __EVENT_INDEX_H__
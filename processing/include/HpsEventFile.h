@@ -7,11 +7,19 @@
 #include "TFile.h"
 #include "TTree.h"
 
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
 
 class HpsEventFile : public IEventFile {
 
  public:
 
+  /** List of [first, last) entry ranges. */
+  typedef std::vector<std::pair<Long64_t, Long64_t> > EntryRanges;
+
   virtual ~HpsEventFile();
   HpsEventFile(const std::string ifilename, const std::string& ofilename);
   virtual bool nextEvent();
@@ -20,15 +28,169 @@ class HpsEventFile : public IEventFile {
   TFile* getOutputFile() { return ofile_;}
   void close();
 
+  /**
+   * Disable the input branches whose address has not been set, so that 
+   * only the branches used by the processors are read from the file. 
+   * Needs to be called after the processors have been initialized.
+   *
+   * @param extra_branches Branches to read even if their address isn't set
+   */
+  void activateUsedBranches(const std::vector<std::string>& extra_branches = {});
+
+  /**
+   * Start the initialization of the processors of a wagon, i.e. a processor 
+   * sequence reading the input tree together with the previous ones.  The 
+   * branch addresses set so far are recorded.
+   */
+  void beginWagon();
+
+  /**
+   * End the initialization of the processors of a wagon.  The branches 
+   * already read by a previous sequence keep their address, and the 
+   * pointers given by the wagon are set to the same objects after each 
+   * entry is read, so that every branch is read once.
+   */
+  void endWagon();
+
+  /**
+   * Create the skim tree, a copy of the input tree in the output file 
+   * holding only the branches to keep.  Needs to be called after the 
+   * processors have been initialized and before activateUsedBranches.
+   *
+   * @param branches Branches kept in the skim.  All the branches are kept 
+   *     if empty.
+   */
+  void setupSkim(const std::vector<std::string>& branches = {});
+
+  /** Copy the current event to the skim tree. */
+  void fillSkim();
+
+  /** Write the skim tree to the output file. */
+  void writeSkim();
+
+  /**
+   * Read the given branches lazily, i.e. only when a processor asks 
+   * for them through IEvent::loadBranch. Needs to be called after 
+   * activateUsedBranches.
+   *
+   * @param lazy_branches Names of the lazy branches
+   */
+  void setLazyBranches(const std::vector<std::string>& lazy_branches);
+
+  /**
+   * Configure the TTreeCache of the input tree.  If no branches are 
+   * given, the cache is primed with the branches read with every event, 
+   * i.e. the active branches excluding the lazy ones.  Needs to be called 
+   * after setLazyBranches.
+   *
+   * @param cache_size Size of the cache in bytes.  0 disables the cache, 
+   *     a negative value keeps the ROOT default.
+   * @param learn_entries If positive, let the cache learn which branches are 
+   *     read during this number of entries instead of priming it.
+   * @param cache_branches Branches added to the cache
+   */
+  void setupCache(Long64_t cache_size, int learn_entries, 
+          const std::vector<std::string>& cache_branches = {});
+
+  /**
+   * Print the read statistics of the input file: the number of read 
+   * calls, the bytes read and the efficiency of the TTreeCache.
+   */
+  void printReadStats();
+
+  /**
+   * Restrict the entries read from the input tree to [first, last). 
+   * Needs to be called after setupEvent.
+   *
+   * @param first First entry to read
+   * @param last One past the last entry to read
+   */
+  void setEntryRange(Long64_t first, Long64_t last);
+
+  /**
+   * Restrict the entries read from the input tree to a list of ordered, 
+   * non overlapping [first, last) ranges.  Needs to be called after setupEvent.
+   *
+   * @param ranges The entry ranges
+   */
+  void setEntryRanges(const EntryRanges& ranges);
+
+  /**
+   * Split the entries [first, last) of a tree in at most nranges contiguous 
+   * ranges. The boundaries of the ranges are aligned to the tree clusters, so 
+   * that no basket is read by more than one range. 
+   *
+   * @param tree The input tree
+   * @param first First entry to consider
+   * @param last One past the last entry to consider
+   * @param nranges Maximum number of ranges
+   * @return The list of [first, last) entry ranges
+   */
+  static EntryRanges getClusterRanges(TTree* tree, Long64_t first, Long64_t last, int nranges);
+
+  /**
+   * Get the entries of a shard of the [first, last) entries of a tree. The 
+   * shards are aligned to the tree clusters, so that the shards of a file 
+   * can be processed by independent jobs without overlap. 
+   *
+   * @param tree The input tree
+   * @param first First entry to consider
+   * @param last One past the last entry to consider
+   * @param shard Index of the shard, from 0 to nshards - 1
+   * @param nshards Number of shards
+   * @param modulo If true, cluster k is assigned to the shard k % nshards. 
+   *     Otherwise each shard is a contiguous block of clusters.
+   * @return The list of [first, last) entry ranges of the shard
+   */
+  static EntryRanges getShardRanges(TTree* tree, Long64_t first, Long64_t last, 
+          int shard, int nshards, bool modulo);
+
+  /**
+   * Keep only the first entries of a list of ranges.
+   *
+   * @param ranges The entry ranges
+   * @param max_entries Maximum number of entries.  Negative for no limit.
+   * @return The truncated entry ranges
+   */
+  static EntryRanges truncateRanges(const EntryRanges& ranges, Long64_t max_entries);
+
 
  private:
 
+  /**
+   * @struct BranchAlias
+   * @brief Pointer to an input object set by a wagon on a branch owned 
+   *        by a previous sequence.
+   */
+  struct BranchAlias {
+    /** Address of the pointer to the object read by the branch owner. */
+    char* owner_{nullptr};
+    /** Address of the pointer given by the wagon. */
+    char* alias_{nullptr};
+  };
+
+  /** Point the wagon pointers to the objects read for the current entry. */
+  void updateAliases();
+
+  /**
+   * Get the start of every cluster of a tree in the [first, last) entries, 
+   * followed by last.
+   */
+  static std::vector<Long64_t> getClusterBounds(TTree* tree, Long64_t first, Long64_t last);
+
   HpsEvent* event_{nullptr};
-  int entry_{0};
-  int maxEntries_{0};
+  Long64_t entry_{0};
+  EntryRanges ranges_;
+  unsigned int irange_{0};
   TFile* ofile_{nullptr};
   TFile* rootfile_{nullptr};
   TTree* intree_{nullptr};
+  std::vector<std::string> activeBranches_;
+  std::vector<std::string> lazyBranches_;
+  std::map<std::string, char*> addresses_;
+  std::vector<BranchAlias> aliases_;
+  TTree* skimtree_{nullptr};
+  std::vector<std::string> skimBranches_;
   
   
   //TTreeReader* ttree_reader;
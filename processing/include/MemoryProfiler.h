@@ -0,0 +1,108 @@
+/**
+ * @file MemoryProfiler.h
+ * @brief Class used to attribute the heap allocations and the memory
+ *        growth of a job to the processors.
+ */
+
+#ifndef __MEMORY_PROFILER_H__
+#define __MEMORY_PROFILER_H__
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <ostream>
+#include <string>
+
+/**
+ * @class MemoryProfiler
+ * @brief Counts the heap allocations and the allocated and freed bytes of
+ *        each stage of the processing, i.e. the initialize, process and
+ *        finalize calls of each processor.  Everything else, like reading
+ *        the input and filling the output, is counted in the "framework"
+ *        stage.
+ *
+ * The stage running on a thread is set with a Scope.  The counters are
+ * incremented by the replacement operator new and delete, which are only
+ * built when hpstr is configured with -DMEMORY_PROFILING=ON.  Without them
+ * only the resident memory is sampled.
+ *
+ * The net bytes of each stage, i.e. the bytes allocated minus the bytes
+ * freed while it runs, are sampled together with the resident memory every
+ * N events.  A stage whose net bytes keep growing from one sample to the
+ * next is reported as a leak suspect at the end of the job.  Memory freed
+ * by another stage than the one which allocated it, like the objects of
+ * the event cleared by the framework, shows up as a growth of the former
+ * and a decrease of the latter.
+ */
+class MemoryProfiler {
+
+    public:
+
+        /**
+         * @struct Stages
+         * @brief Indices of the stages of a processor.
+         */
+        struct Stages {
+            int initialize_{0};
+            int process_{0};
+            int finalize_{0};
+        };
+
+        /**
+         * @class Scope
+         * @brief Attributes the allocations of the current thread to a
+         *        stage until it goes out of scope.
+         */
+        class Scope {
+            public:
+                /** @param stage Index of the stage */
+                Scope(int stage);
+                ~Scope();
+                Scope(const Scope&) = delete;
+                Scope& operator=(const Scope&) = delete;
+            private:
+                /** Stage running before this scope. */
+                int previous_;
+        };
+
+        /**
+         * Enable the profiling.
+         * @param interval Number of events between two samples
+         */
+        static void enable(long interval);
+
+        /** @return True if the profiling is enabled. */
+        static bool enabled();
+
+        /** @return True if the allocations are counted. */
+        static bool countsAllocations();
+
+        /**
+         * Add the stages of a processor.  A processor added twice keeps its
+         * stages.
+         * @param name Name of the processor
+         * @return Indices of the stages
+         */
+        static Stages addProcessor(const std::string& name);
+
+        /**
+         * Sample the memory if n_events is a multiple of the interval.
+         * @param n_events Number of processed events
+         */
+        static void sample(long n_events);
+
+        /**
+         * Print the allocations of each stage and the leak suspects.
+         * @param out The stream to print to
+         */
+        static void print(std::ostream& out);
+
+        /** @return The resident memory of the process in bytes. */
+        static long residentBytes();
+
+        /** @return The high-water mark of the resident memory in bytes. */
+        static long peakResidentBytes();
+
+}; // MemoryProfiler
+
+#endif // __MEMORY_PROFILER_H__
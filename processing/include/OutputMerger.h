@@ -0,0 +1,63 @@
+/**
+ * @file OutputMerger.h
+ * @brief Class used to merge the ROOT output files of hpstr jobs.
+ */
+
+#ifndef __OUTPUT_MERGER_H__
+#define __OUTPUT_MERGER_H__
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <string>
+#include <vector>
+
+/**
+ * @class OutputMerger
+ * @brief Merges hpstr output files, i.e. the HistoManager folders, the 
+ *        BaseSelector cut flows, the FlatTupleMaker trees and event_h.
+ *
+ * The files are merged with a tree reduction: the inputs are split in 
+ * groups of at most fan-in files, each group is merged into an intermediate 
+ * file by one of the worker threads, and the procedure is repeated on the 
+ * intermediate files until a single group is left, which is merged into 
+ * the output file.  The groups are merged incrementally, so that the keys 
+ * of only one input file are held in memory at a time.
+ */
+class OutputMerger {
+
+    public:
+
+        /**
+         * Class constructor.
+         * @param threads Number of files merged in parallel
+         * @param fanin Maximum number of files merged into each intermediate file
+         */
+        OutputMerger(int threads = 1, int fanin = 16);
+
+        /**
+         * Merge the input files into the output file. The inputs are added 
+         * following their order in the list.
+         * @param inputs List of input files
+         * @param output Output file
+         */
+        void merge(const std::vector<std::string>& inputs, const std::string& output);
+
+    private:
+
+        /**
+         * Merge a group of files.
+         * @param inputs List of input files
+         * @param output Output file
+         * @return An error message, empty on success
+         */
+        std::string mergeGroup(const std::vector<std::string>& inputs, const std::string& output) const;
+
+        /** Number of files merged in parallel. */
+        int threads_{1};
+
+        /** Maximum number of files merged into each file. */
+        int fanin_{16};
+};
+
+#endif // __OUTPUT_MERGER_H__
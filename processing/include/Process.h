@@ -14,6 +14,7 @@
 #include <vector>
 #include <iostream>
 #include <stdexcept>
+#include <string>
 
 //----------//
 //   ROOT   //
@@ -24,7 +25,13 @@
 //-----------//
 //   hpstr   //
 //-----------//
+#include "BranchProfile.h"
+#include "EventFile.h"
+#include "HpsEventFile.h"
 #include "Processor.h"
+#include "ParameterSet.h"
+#include "ProcessTimer.h"
+#include "MemoryProfiler.h"
 
 
 class Process {
@@ -43,6 +50,28 @@ class Process {
          */
         void addToSequence(Processor* event_proc);
 
+        /**
+         * Record the configuration used to build a processor of the sequence.  
+         * The configurations are used to build independent copies of the 
+         * sequence, i.e. one for each worker thread.
+         * @param classname Class name of the processor
+         * @param instancename Instance name of the processor
+         * @param params Parameters passed to the processor
+         */
+        void addProcessorConfig(const std::string& classname, const std::string& instancename, 
+                const ParameterSet& params);
+
+        /**
+         * Add a wagon, i.e. an independent processor sequence with its own 
+         * output files, reading the same events as the main sequence in run 
+         * modes 1 and 3.  The input files are read once for all the wagons.
+         * @param name Name of the wagon
+         * @param sequence The processors of the wagon, in order
+         * @param output_files Output file names, one for each input file
+         */
+        void addWagon(const std::string& name, const std::vector<Processor*>& sequence, 
+                const std::vector<std::string>& output_files);
+
         /**
          * Add an input file name to the list.
          * @param filename Input ROOT event file name
@@ -62,6 +91,7 @@ class Process {
          *     0 indicates LCIO to ROOT.
          *     1 indicates ROOT to Histo.
          *     2 indicates Histo Analysis.
+         *     3 indicates ROOT to Histo on the events of an event list.
          */
         void setRunMode(int run_mode=-1) {
             run_mode_ = run_mode;
@@ -72,10 +102,264 @@ class Process {
          * when either there are no more input events or when this number of events have been processed.
          * @param event_limit Maximum number of events to process.  -1 indicates no limit.
          */
-        void setEventLimit(int event_limit=-1) {
+        void setEventLimit(long event_limit=-1) {
             event_limit_ = event_limit;
         }
 
+        /**
+         * Restrict the events read from each input file to [first_event, last_event).
+         * @param first_event Index of the first event
+         * @param last_event One past the index of the last event. -1 reads until the end of the file.
+         */
+        void setEventRange(long first_event=0, long last_event=-1) {
+            first_event_ = first_event;
+            last_event_ = last_event;
+        }
+
+        /**
+         * Process only a shard of the selected events of each input file, so 
+         * that a file can be split across independent jobs without overlap. 
+         * In run mode 1 the shards are aligned to the tree clusters.
+         * @param shard_index Index of the shard, from 0 to n_shards - 1
+         * @param n_shards Number of shards
+         * @param modulo If true, the clusters (events for LCIO) are assigned to the 
+         *     shards in turn. Otherwise each shard is a contiguous block.
+         */
+        void setShard(int shard_index=0, int n_shards=1, bool modulo=false) {
+            shard_index_ = shard_index;
+            n_shards_ = n_shards;
+            shard_modulo_ = modulo;
+        }
+
+        /**
+         * Set the event list used in run mode 3.
+         * @param event_list Name of a text file with one "run event" pair per line
+         */
+        void setEventList(const std::string& event_list) {
+            event_list_file_ = event_list;
+        }
+
+        /**
+         * Write the run/event index of the output files in run mode 0.
+         * @param build_index If true, the index is written next to each output file
+         */
+        void setBuildIndex(bool build_index=false) {
+            build_index_ = build_index;
+        }
+
+        /**
+         * Set the number of threads used to process the events in run mode 1. 
+         * The input tree is split in entry ranges aligned to the TTree 
+         * clusters, each range being processed by an independent copy of 
+         * the processor sequence.
+         * @param threads Number of worker threads. 1 or less runs on the main thread.
+         */
+        void setThreads(int threads=1) {
+            threads_ = threads;
+        }
+
+        /**
+         * Set the number of worker processes used to convert the input 
+         * files in run mode 0.  Each worker converts one input file into 
+         * its matching output file.  The event limit applies to each file.
+         * @param workers Number of worker processes. 1 or less converts the files sequentially.
+         */
+        void setWorkers(int workers=1) {
+            workers_ = workers;
+        }
+
+        /**
+         * Set the number of threads running the processors of an event 
+         * concurrently in run mode 0.  Processors which declared the 
+         * collections they consume and produce are grouped in waves of 
+         * independent processors, run in the order of the sequence. 
+         * Processors without declarations run alone.  Unlike in sequence, 
+         * a processor which already started when an earlier processor of 
+         * its wave rejects the event still processes it, so processors 
+         * with side effects, e.g. histogram fills, can see more events.
+         * @param concurrent_processors Number of threads. 1 or less runs the processors in sequence.
+         */
+        void setConcurrentProcessors(int concurrent_processors=1) {
+            concurrent_processors_ = concurrent_processors;
+        }
+
+        /**
+         * Set the number of LCIO events decoded ahead by a background 
+         * reader thread in run mode 0.
+         * @param read_ahead Number of events. 0 reads the events on the processing thread.
+         */
+        void setReadAhead(int read_ahead=0) {
+            read_ahead_ = read_ahead;
+        }
+
+        /**
+         * Set the number of threads used to compress the output baskets in 
+         * run mode 0, using ROOT implicit multi-threading.
+         * @param write_threads Number of threads. 0 compresses on the processing thread.
+         */
+        void setWriteThreads(int write_threads=0) {
+            write_threads_ = write_threads;
+        }
+
+        /**
+         * Set the amount of uncompressed data buffered before the output 
+         * baskets are flushed when compressing with multiple threads.  Filling 
+         * the tree blocks while the buffered baskets are compressed and written.
+         * @param write_buffer Buffer size in bytes
+         */
+        void setWriteBuffer(long write_buffer=30000000) {
+            write_buffer_ = write_buffer;
+        }
+
+        /**
+         * Write flat, struct-of-arrays columns of the output collections 
+         * next to their object branches in run mode 0, e.g. 
+         * GBLTracks_d0[nGBLTracks].  References are written as indices in 
+         * the collections of the same event.
+         * @param columnar If true, the columns are written
+         */
+        void setColumnar(bool columnar=false) {
+            columnar_ = columnar;
+        }
+
+        /**
+         * Add a collection written as columns.  All the supported 
+         * collections are written if none is added.
+         * @param collection Name of the collection
+         */
+        void addColumnarCollection(const std::string& collection) {
+            columnar_collections_.push_back(collection);
+        }
+
+        /**
+         * Add a storage profile for the output branches in run mode 0.
+         * @param profile The compression and basket settings of the matching branches
+         */
+        void addBranchProfile(const BranchProfile& profile) {
+            branch_profiles_.push_back(profile);
+        }
+
+        /**
+         * Get the split level of an output branch from the storage profiles.
+         * @param name Name of the branch
+         * @param splitlevel Split level used if no profile sets one for the branch
+         * @return The split level of the last matching profile setting one
+         */
+        int getSplitLevel(const std::string& name, int splitlevel) const;
+
+        /**
+         * Set the auto-flush of the output tree in run mode 0.  ROOT only 
+         * supports this setting for the whole tree.
+         * @param auto_flush Number of entries if positive, number of bytes if 
+         *     negative, 0 keeps the default.
+         */
+        void setAutoFlush(long auto_flush=0) {
+            auto_flush_ = auto_flush;
+        }
+
+        /**
+         * Enable the timing report.  The time spent reading the input, in 
+         * each processor and filling the output is printed at the end of 
+         * each file and, in run modes 0 and 1, written to the output file.
+         * @param timing If true, the timing report is produced
+         */
+        void setTiming(bool timing=true) {
+            timing_ = timing;
+        }
+
+        /**
+         * Enable the memory profiling in run modes 0 and 1.  The resident 
+         * memory is printed every memory_profile events, and the 
+         * allocations of each processor and the leak suspects at the end 
+         * of each file.
+         * @param memory_profile Number of events between two samples.  0 disables the profiling.
+         */
+        void setMemoryProfile(long memory_profile=0) {
+            memory_profile_ = memory_profile;
+            MemoryProfiler::enable(memory_profile);
+        }
+
+        /**
+         * Write the events passing all the processors to a HPS_Event tree 
+         * in the output file in run mode 1.
+         * @param skim If true, the skim tree is written
+         */
+        void setSkim(bool skim=false) {
+            skim_ = skim;
+        }
+
+        /**
+         * Add a branch kept in the skim tree.  All the branches are kept if 
+         * none is added.
+         * @param branch Name of the branch
+         */
+        void addSkimBranch(const std::string& branch) {
+            skim_branches_.push_back(branch);
+        }
+
+        /**
+         * Read only the input branches used by the processors in run mode 1. 
+         * A branch is used if a processor set its address during initialization.
+         * The collections only reached through a TRef or a TRefArray aren't 
+         * used in this sense and need to be added with addExtraBranch, 
+         * otherwise the references resolve to null.
+         * @param active_branches_only If false, all the input branches are read.
+         */
+        void setActiveBranchesOnly(bool active_branches_only=true) {
+            active_branches_only_ = active_branches_only;
+        }
+
+        /**
+         * Add an input branch that is read even if no processor set its address.
+         * @param branch Name of the branch
+         */
+        void addExtraBranch(const std::string& branch) {
+            extra_branches_.push_back(branch);
+        }
+
+        /**
+         * Add an input branch that is only read when a processor requests 
+         * it through IEvent::loadBranch.  Used in run mode 1.
+         * @param branch Name of the branch
+         */
+        void addLazyBranch(const std::string& branch) {
+            lazy_branches_.push_back(branch);
+        }
+
+        /**
+         * Set the size of the TTreeCache of the input files in run mode 1.
+         * @param cache_size Size in bytes. 0 disables the cache, a negative value keeps the ROOT default.
+         */
+        void setCacheSize(long cache_size=-1) {
+            cache_size_ = cache_size;
+        }
+
+        /**
+         * Set the number of entries used by the TTreeCache to learn which 
+         * branches are read.  If not positive, the cache is primed with the 
+         * cache branches or, if none are given, with the active branches.
+         * @param learn_entries Number of entries of the learning phase
+         */
+        void setCacheLearnEntries(int learn_entries=0) {
+            cache_learn_entries_ = learn_entries;
+        }
+
+        /**
+         * Add an input branch to the TTreeCache.
+         * @param branch Name of the branch
+         */
+        void addCacheBranch(const std::string& branch) {
+            cache_branches_.push_back(branch);
+        }
+
+        /**
+         * Enable the asynchronous prefetching of the input files in run mode 1.
+         * @param async_prefetch If true, the baskets are prefetched in a separate thread
+         */
+        void setAsyncPrefetch(bool async_prefetch=false) {
+            async_prefetch_ = async_prefetch;
+        }
+
         /**
          * Get the run mode of the process.
          */
@@ -92,11 +376,117 @@ class Process {
         /** Run the Histo Analysis process. */
         void runOnHisto();
 
+        /** 
+         * Run the ROOT to Histo process on the events of the event list.  
+         * The entries are found with the index of each input file. 
+         */
+        void runOnEventList();
+
         /** Request that the processing finish with this event. */ 
         void requestFinish() { event_limit_ = 0; }
 
     private:
 
+        /**
+         * Run the ROOT to Histo process on a single input file using 
+         * multiple threads.  The results of each worker are written to 
+         * a temporary file, and merged into the output file in the order 
+         * of the entry ranges.
+         * @param ifile Input ROOT file
+         * @param ofile Output ROOT file
+         * @param n_events_processed Number of events processed so far in the job
+         */
+        void runOnRootThreaded(const std::string& ifile, const std::string& ofile, long& n_events_processed);
+
+        /**
+         * Run the LCIO to ROOT process on a single input file.
+         * @param ifile Input LCIO file
+         * @param ofile Output ROOT file
+         * @param n_events_processed Number of events processed so far in the job
+         */
+        void processLcioFile(const std::string& ifile, const std::string& ofile, long& n_events_processed);
+
+        /**
+         * Convert the input files using a pool of forked worker processes. 
+         * The workers report their progress to the parent through a pipe.
+         */
+        void runWorkers();
+
+        /**
+         * Report the number of events processed by a worker to the parent process.
+         * @param n_events Number of events processed so far
+         */
+        void reportProgress(long n_events);
+
+        /**
+         * Get the entries of an input tree selected by the event list or, 
+         * if there is none, by the event range and the shard settings.
+         * @param tree The input tree
+         * @param ifile Name of the input file
+         * @return The selected entry ranges
+         */
+        HpsEventFile::EntryRanges getEntryRanges(TTree* tree, const std::string& ifile);
+
+        /**
+         * Select the events of an LCIO file read according to the event 
+         * range and the shard settings.
+         * @param file The LCIO file
+         */
+        void selectEvents(EventFile* file);
+
+        /**
+         * Create a timer with one stage for reading the input, one stage 
+         * per processor and optionally one stage for filling the output.
+         * @param sequence The processor sequence
+         * @param fill If true, add the stage filling the output
+         * @return The timer
+         */
+        ProcessTimer makeTimer(const std::vector<Processor*>& sequence, bool fill);
+
+        /**
+         * Get the memory profiler stages of the processors of a sequence.
+         * @param sequence The processor sequence
+         * @return The stages of each processor
+         */
+        std::vector<MemoryProfiler::Stages> makeMemoryStages(const std::vector<Processor*>& sequence);
+
+        /**
+         * Group the processors of a sequence in waves.  A processor is placed 
+         * in the wave following the last preceding processor it conflicts 
+         * with, i.e. one producing a collection it consumes or produces, or 
+         * consuming a collection it produces.  Processors without 
+         * declarations conflict with all the others.
+         * @param sequence The processor sequence
+         * @return The indices of the processors in each wave
+         */
+        std::vector<std::vector<int> > makeWaves(const std::vector<Processor*>& sequence);
+
+        /**
+         * Build a new copy of the processor sequence from the configurations.
+         * @return The sequence of newly created and configured processors.
+         */
+        std::vector<Processor*> makeSequence();
+
+        /**
+         * @struct ProcessorConfig
+         * @brief Configuration used to create a Processor of the sequence.
+         */
+        struct ProcessorConfig {
+            std::string classname_;
+            std::string instancename_;
+            ParameterSet params_;
+        };
+
+        /**
+         * @struct Wagon
+         * @brief Processor sequence sharing the input of the main sequence.
+         */
+        struct Wagon {
+            std::string name_;
+            std::vector<Processor*> sequence_;
+            std::vector<std::string> output_files_;
+        };
+
         /** Reader used to parse either binary or EVIO files. */
         //DataRead* data_reader{nullptr}; 
 
@@ -104,11 +494,107 @@ class Process {
         int run_mode_{-1};
 
         /** Limit on events to process. */
-        int event_limit_{-1};
+        long event_limit_{-1};
+
+        /** Index of the first event read from each file. */
+        long first_event_{0};
+
+        /** One past the index of the last event read from each file. -1 for no limit. */
+        long last_event_{-1};
+
+        /** Index of the shard processed by this job. */
+        int shard_index_{0};
+
+        /** Number of shards each file is split in. */
+        int n_shards_{1};
+
+        /** Assign the clusters (events for LCIO) to the shards in turn. */
+        bool shard_modulo_{false};
+
+        /** Name of the event list file used in run mode 3. */
+        std::string event_list_file_;
+
+        /** Run and event numbers of the events to process in run mode 3. */
+        std::vector<std::pair<int, int> > event_list_;
+
+        /** Write the run/event index of the output files in run mode 0. */
+        bool build_index_{false};
+
+        /** Number of threads used in run mode 1. */
+        int threads_{1};
+
+        /** Number of worker processes used in run mode 0. */
+        int workers_{1};
+
+        /** Write the passing events to a skim tree in run mode 1. */
+        bool skim_{false};
+
+        /** Branches kept in the skim tree. */
+        std::vector<std::string> skim_branches_;
+
+        /** Read only the input branches used by the processors in run mode 1. */
+        bool active_branches_only_{false};
+
+        /** Input branches read in addition to the ones used by the processors. */
+        std::vector<std::string> extra_branches_;
+
+        /** Input branches read only on request. */
+        std::vector<std::string> lazy_branches_;
+
+        /** Size of the input TTreeCache in bytes. Negative for the ROOT default. */
+        long cache_size_{-1};
+
+        /** Number of entries used to train the input TTreeCache. */
+        int cache_learn_entries_{0};
+
+        /** Input branches added to the TTreeCache. */
+        std::vector<std::string> cache_branches_;
+
+        /** Prefetch the input baskets asynchronously. */
+        bool async_prefetch_{false};
+
+        /** Number of threads running the processors of an event in run mode 0. */
+        int concurrent_processors_{1};
+
+        /** Number of LCIO events decoded ahead in run mode 0. */
+        int read_ahead_{0};
+
+        /** Number of threads compressing the output baskets in run mode 0. */
+        int write_threads_{0};
+
+        /** Uncompressed bytes buffered before flushing the output baskets. */
+        long write_buffer_{30000000};
+
+        /** Storage profiles of the output branches in run mode 0. */
+        std::vector<BranchProfile> branch_profiles_;
+
+        /** Write the flat columns of the output collections in run mode 0. */
+        bool columnar_{false};
+
+        /** Collections written as columns.  All the supported ones if empty. */
+        std::vector<std::string> columnar_collections_;
+
+        /** Auto-flush of the output tree in run mode 0.  0 keeps the default. */
+        long auto_flush_{0};
+
+        /** Produce the timing report. */
+        bool timing_{true};
+
+        /** Number of events between two memory samples.  0 if not profiling. */
+        long memory_profile_{0};
+
+        /** Pipe used by a worker process to report its progress.  -1 if not a worker. */
+        int progress_fd_{-1};
 
         /** Ordered list of Processors to execute. */
         std::vector<Processor*> sequence_;
 
+        /** Configurations of the processors in the sequence. */
+        std::vector<ProcessorConfig> configs_;
+
+        /** Processor sequences reading the same events as the main sequence. */
+        std::vector<Wagon> wagons_;
+
         /** List of input files to process.  May be empty if this Process will generate new events. */
         std::vector<std::string> input_files_;
 
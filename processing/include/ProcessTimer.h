@@ -0,0 +1,111 @@
+/**
+ * @file ProcessTimer.h
+ * @brief Class used to accumulate the time spent in each stage of the 
+ *        event processing.
+ */
+
+#ifndef __PROCESS_TIMER_H__
+#define __PROCESS_TIMER_H__
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//----------//
+//   ROOT   //
+//----------//
+#include "TDirectory.h"
+
+/**
+ * @class ProcessTimer
+ * @brief Accumulates the call count, the pass count and the latency 
+ *        distribution of each processing stage, i.e. reading the input, 
+ *        each processor and filling the output.  The latencies are stored 
+ *        in logarithmic buckets, which are used to estimate the percentiles.
+ */
+class ProcessTimer {
+
+    public:
+
+        /** Clock used to time the stages. */
+        typedef std::chrono::steady_clock Clock;
+
+        /**
+         * Add a stage. 
+         * @param name Name of the stage
+         * @return Index of the stage, used to record its timing
+         */
+        int addStage(const std::string& name);
+
+        /**
+         * Record a call of a stage.
+         * @param stage Index of the stage
+         * @param start Time at which the call started
+         * @param pass Result of the call
+         * @return The current time, which can be used to start the next stage
+         */
+        Clock::time_point record(int stage, const Clock::time_point& start, bool pass = true);
+
+        /**
+         * Add the timing of another timer with the same stages.
+         * @param other The timer to merge
+         */
+        void merge(const ProcessTimer& other);
+
+        /**
+         * Print the timing report.
+         * @param out Output stream
+         */
+        void print(std::ostream& out) const;
+
+        /** @return The timing summary as a JSON string. */
+        std::string toJson() const;
+
+        /**
+         * Write the total time per stage as a histogram, and the summary 
+         * as JSON, to a directory.
+         * @param dir Output directory
+         */
+        void write(TDirectory* dir) const;
+
+    private:
+
+        /**
+         * @struct Stage
+         * @brief Timing accumulated for a stage.
+         */
+        struct Stage {
+            std::string name_;
+            long calls_{0};
+            long passed_{0};
+            double total_{0};
+            double max_{0};
+            std::vector<long> buckets_;
+        };
+
+        /**
+         * Estimate a percentile of the latency of a stage.
+         * @param stage The stage
+         * @param fraction The percentile, between 0 and 1
+         * @return The latency in seconds
+         */
+        double percentile(const Stage& stage, double fraction) const;
+
+        /** Number of latency buckets per decade. */
+        static constexpr int BUCKETS_PER_DECADE{10};
+
+        /** Lower edge of the first latency bucket, in seconds. */
+        static constexpr double MIN_LATENCY{1e-8};
+
+        /** Number of latency buckets, covering up to 1000 s. */
+        static constexpr int N_BUCKETS{11*BUCKETS_PER_DECADE};
+
+        /** The timed stages. */
+        std::vector<Stage> stages_;
+};
+
+#endif // __PROCESS_TIMER_H__
@@ -11,16 +11,22 @@
 //   C++ StdLib   //
 //----------------//
 #include <map>
+#include <string>
+#include <vector>
 
 //-----------//
 //   hpstr   //
 //-----------//
 #include "ParameterSet.h"
 
+//----------//
+//   ROOT   //
+//----------//
+#include "TTree.h"
+
 // Forward declarations
 class Process;
 class Processor;
-class TTree;
 class TFile;
 class IEvent;
 
@@ -107,6 +113,22 @@ class Processor {
          */
         static void declare(const std::string& classname, ProcessorMaker*);
 
+        /** @return The name of this instance of the Processor. */
+        const std::string& getName() const { return name_; }
+
+        /** @return The collections read by the Processor. */
+        const std::vector<std::string>& getConsumes() const { return consumes_; }
+
+        /** @return The collections written by the Processor. */
+        const std::vector<std::string>& getProduces() const { return produces_; }
+
+        /** 
+         * @return True if the Processor declared the collections it reads and writes. 
+         * Processors which don't are run after all the preceding processors and 
+         * before all the following ones.
+         */
+        bool hasDependencies() const { return !consumes_.empty() || !produces_.empty(); }
+
     protected:
 
         /** Handle to the Process. */
@@ -117,9 +139,48 @@ class Processor {
 
     protected:
 
+        /**
+         * Declare a collection read by the Processor, i.e. an LCIO collection 
+         * or a branch written by another Processor.
+         * @param collection Name of the collection
+         */
+        void declareConsumes(const std::string& collection) { consumes_.push_back(collection); }
+
+        /**
+         * Declare a collection written by the Processor.
+         * @param collection Name of the collection
+         */
+        void declareProduces(const std::string& collection) { produces_.push_back(collection); }
+
+        /**
+         * Create an output branch with the split level of the storage 
+         * profile matching its name, if any.
+         * @param tree The output tree
+         * @param name Name of the branch
+         * @param object Address of the pointer or collection written
+         * @param bufsize Basket size of the branch
+         * @param splitlevel Split level used if no profile sets one
+         * @return The branch
+         */
+        template <typename T>
+            TBranch* addBranch(TTree* tree, const std::string& name, T* object, 
+                    int bufsize = 32000, int splitlevel = 99) {
+                return tree->Branch(name.c_str(), object, bufsize, getSplitLevel(name, splitlevel));
+            }
+
         /** The name of the Processor. */
         std::string name_;
 
+    private:
+
+        /** @return The split level of a branch, see Process::getSplitLevel */
+        int getSplitLevel(const std::string& name, int splitlevel) const;
+
+        /** Collections read by the Processor. */
+        std::vector<std::string> consumes_;
+
+        /** Collections written by the Processor. */
+        std::vector<std::string> produces_;
 
 };
 
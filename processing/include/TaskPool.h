@@ -0,0 +1,84 @@
+/**
+ * @file TaskPool.h
+ * @brief Pool of threads used to run groups of tasks concurrently.
+ */
+
+#ifndef __TASK_POOL_H__
+#define __TASK_POOL_H__
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class TaskPool
+ * @brief Runs groups of tasks on a fixed set of threads.  The calling 
+ *        thread takes part in the execution, so a pool of n threads 
+ *        creates n - 1 additional threads.
+ */
+class TaskPool {
+
+    public:
+
+        /**
+         * Class constructor.
+         * @param nthreads Number of threads running the tasks, including the calling thread
+         */
+        TaskPool(int nthreads);
+
+        /** Class destructor. Stops the threads. */
+        ~TaskPool();
+
+        /**
+         * Run a group of tasks, returning once all of them are done.  If a 
+         * task throws, the first exception is rethrown once the group is done.
+         * @param tasks The tasks to run
+         */
+        void run(const std::vector<std::function<void()> >& tasks);
+
+    private:
+
+        /** Loop of the pool threads. */
+        void work();
+
+        /** 
+         * Run the next task of the current group.
+         * @param lock Lock on the pool mutex, released while the task runs
+         */
+        void runNext(std::unique_lock<std::mutex>& lock);
+
+        /** The pool threads. */
+        std::vector<std::thread> threads_;
+
+        /** Protects the state of the current group. */
+        std::mutex mutex_;
+
+        /** Signals a new group of tasks or the end of the pool. */
+        std::condition_variable work_cv_;
+
+        /** Signals the completion of the group. */
+        std::condition_variable done_cv_;
+
+        /** The current group of tasks.  Null when idle. */
+        const std::vector<std::function<void()> >* tasks_{nullptr};
+
+        /** Index of the next task to start. */
+        size_t next_{0};
+
+        /** Number of tasks of the group not finished yet. */
+        size_t pending_{0};
+
+        /** First exception thrown by a task of the group. */
+        std::exception_ptr error_;
+
+        /** Request the threads to stop. */
+        bool stop_{false};
+};
+
+#endif // __TASK_POOL_H__
@@ -14,15 +14,70 @@ class Processor:
             for key, value in self.parameters.items():
                 print("\t\t\t [ %s ]: %s" % (key, value))
 
+class BranchProfile:
+
+    def __init__(self, branches, compression="", level=-1, basket_size=-1, split_level=-1):
+        self.branches    = branches
+        self.compression = compression
+        self.level       = level
+        self.basket_size = basket_size
+        self.split_level = split_level
+
+    def toString(self):
+        print("\tBranchProfile( %s ): compression %s, level %d, basket size %d, split level %d" % 
+                (self.branches, self.compression if self.compression else "default", 
+                    self.level, self.basket_size, self.split_level))
+
+class Wagon:
+
+    def __init__(self, name):
+        self.name         = name
+        self.sequence     = []
+        self.output_files = []
+
+    def toString(self):
+        print("\tWagon( %s ) -> %s" % (self.name, ", ".join(self.output_files)))
+        for proc in self.sequence:
+            proc.toString()
+
 class Process: 
 
     lastProcess=None
 
     def __init__(self): 
         self.max_events = -1
+        self.first_event = 0
+        self.event_list = ""
+        self.build_index = 0
+        self.last_event = -1
+        self.shard_index = 0
+        self.n_shards = 1
+        self.shard_mode = "contiguous"
+        self.threads = 1
+        self.workers = 1
+        self.timing = 1
+        self.memory_profile = 0
+        self.read_ahead = 0
+        self.concurrent_processors = 1
+        self.write_threads = 0
+        self.write_buffer = 30000000
+        self.auto_flush = 0
+        self.branch_profiles = []
+        self.columnar = 0
+        self.columnar_collections = []
+        self.skim = 0
+        self.skim_branches = []
+        self.active_branches_only = 0
+        self.extra_branches = []
+        self.lazy_branches = []
+        self.cache_size = -1
+        self.cache_learn_entries = 0
+        self.cache_branches = []
+        self.async_prefetch = 0
         self.input_files = []
         self.output_files = []
         self.sequence = []
+        self.wagons = []
         self.libraries = []
         Process.lastProcess=self
 
@@ -44,10 +99,42 @@ class Process:
         
         if (self.max_events > 0): print(" Maximum events to process: %d" % (self.max_events))
         else: print(" No limit on maximum events to process")
+        if (self.first_event > 0 or self.last_event >= 0): print(" Event range: [%d, %d)" % (self.first_event, self.last_event))
+        if (self.event_list): print(" Event list: %s" % (self.event_list))
+        if (self.build_index): print(" Writing the run/event index of the output files")
+        if (self.n_shards > 1): print(" Shard %d of %d (%s)" % (self.shard_index, self.n_shards, self.shard_mode))
+        if (self.threads > 1): print(" Number of threads: %d" % (self.threads))
+        if (self.workers > 1): print(" Number of workers: %d" % (self.workers))
+        if (self.memory_profile > 0): print(" Memory profile every %d events" % (self.memory_profile))
+        if (self.read_ahead > 0): print(" LCIO events read ahead: %d" % (self.read_ahead))
+        if (self.concurrent_processors > 1): print(" Concurrent processor threads: %d" % (self.concurrent_processors))
+        if (self.write_threads > 0): print(" Output compression threads: %d" % (self.write_threads))
+        if (self.columnar):
+            if len(self.columnar_collections) > 0: print(" Writing the columns of: %s" % (", ".join(self.columnar_collections)))
+            else: print(" Writing the columns of all the supported collections")
+        if (self.skim):
+            if len(self.skim_branches) > 0: print(" Skimming passing events, keeping: %s" % (", ".join(self.skim_branches)))
+            else: print(" Skimming passing events, keeping all branches")
+        if (self.active_branches_only):
+            print(" Reading only the used input branches")
+            if len(self.extra_branches) > 0: print(" Extra input branches: %s" % (", ".join(self.extra_branches)))
+        if len(self.lazy_branches) > 0: print(" Lazy input branches: %s" % (", ".join(self.lazy_branches)))
+        if (self.cache_size >= 0): print(" Input cache size: %d bytes" % (self.cache_size))
+        if (self.async_prefetch): print(" Asynchronous prefetching enabled")
+
+        if (self.auto_flush != 0): print(" Output auto-flush: %d" % (self.auto_flush))
+        if len(self.branch_profiles) > 0:
+            print("Branch profiles:")
+            for profile in self.branch_profiles:
+                profile.toString()
 
         print("Processor sequence:")
         for proc in self.sequence:
             proc.toString()
+        if len(self.wagons) > 0:
+            print("Wagons:")
+            for wagon in self.wagons:
+                wagon.toString()
         if len(self.input_files) > 0:
             if len(self.output_files)==len(self.input_files):
                 print("Files:")
@@ -0,0 +1,399 @@
+/**
+ * @file ColumnarWriter.cxx
+ * @brief Class writing flat, struct-of-arrays copies of the collections
+ *        of the event tree.
+ */
+
+#include "ColumnarWriter.h"
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <algorithm>
+#include <iostream>
+
+//----------//
+//   ROOT   //
+//----------//
+#include <TBranchElement.h>
+
+//-----------//
+//   hpstr   //
+//-----------//
+#include "CalCluster.h"
+#include "CalHit.h"
+#include "MCParticle.h"
+#include "Particle.h"
+#include "RawSvtHit.h"
+#include "Track.h"
+#include "TrackerHit.h"
+#include "Vertex.h"
+
+namespace {
+
+    /** Bind a collection to the vector of objects of its branch. */
+    template <class T, class C>
+    void bindVector(C& collection, char* object) {
+        auto objects = reinterpret_cast<std::vector<T*>*>(object);
+        collection.size_ = [objects]() { return objects->size(); };
+        collection.at_ = [objects](std::size_t i) -> TObject* { return objects->at(i); };
+    }
+
+    /** Grow the buffer of a branch to hold at least size values. */
+    template <class V>
+    void reserve(std::vector<V>& buffer, std::size_t size, TBranch* branch) {
+        if (buffer.size() >= size) return;
+        buffer.resize(std::max(size, 2*buffer.size()));
+        branch->SetAddress(buffer.data());
+    }
+
+    /** Copy the first values of a vector, padding with zeros. */
+    template <class V>
+    void copyValues(const std::vector<V>& values, int width, double* out) {
+        for (int i = 0; i < width; ++i)
+            out[i] = i < (int) values.size() ? values[i] : 0;
+    }
+}
+
+ColumnarWriter::ColumnarWriter(TTree* tree, const std::vector<std::string>& collections)
+    : tree_(tree) {
+
+    TObjArray* branches = tree_->GetListOfBranches();
+    for (int ibranch = 0; ibranch < branches->GetEntriesFast(); ++ibranch) {
+        auto branch = dynamic_cast<TBranchElement*>(branches->At(ibranch));
+        if (!branch || !branch->GetObject()) continue;
+
+        std::string name = branch->GetName();
+        if (!collections.empty()
+                && std::find(collections.begin(), collections.end(), name) == collections.end())
+            continue;
+
+        // Only vectors of pointers, i.e. vector<Track*>, are supported
+        std::string class_name = branch->GetClassName();
+        if (class_name.compare(0, 7, "vector<") != 0
+                || class_name.compare(class_name.size() - 2, 2, "*>") != 0)
+            continue;
+        std::string type = class_name.substr(7, class_name.size() - 9);
+
+        Collection collection;
+        collection.name_ = name;
+        char* object = branch->GetObject();
+        if (type == "Track") {
+            bindVector<Track>(collection, object);
+            addTrack(collection);
+        } else if (type == "TrackerHit") {
+            bindVector<TrackerHit>(collection, object);
+            addTrackerHit(collection);
+        } else if (type == "RawSvtHit") {
+            bindVector<RawSvtHit>(collection, object);
+            addRawSvtHit(collection);
+        } else if (type == "CalHit") {
+            bindVector<CalHit>(collection, object);
+            addCalHit(collection);
+        } else if (type == "CalCluster") {
+            bindVector<CalCluster>(collection, object);
+            addCalCluster(collection);
+        } else if (type == "Vertex") {
+            bindVector<Vertex>(collection, object);
+            addVertex(collection);
+        } else if (type == "Particle") {
+            bindVector<Particle>(collection, object);
+            addParticle(collection);
+        } else if (type == "MCParticle") {
+            bindVector<MCParticle>(collection, object);
+            addMCParticle(collection);
+        } else {
+            if (!collections.empty())
+                std::cout << "[ ColumnarWriter ]: No columns for " << name
+                    << " of type " << class_name << std::endl;
+            continue;
+        }
+        collections_.push_back(std::move(collection));
+    }
+
+    // The buffers don't move anymore once the collections are in place
+    for (auto& collection : collections_) makeBranches(collection);
+}
+
+void ColumnarWriter::fill() {
+
+    // The links refer to the position of the objects in their collection
+    indices_.clear();
+    for (auto& collection : collections_) {
+        collection.n_ = collection.size_();
+        for (Int_t i = 0; i < collection.n_; ++i)
+            indices_.emplace(collection.at_(i), i);
+    }
+
+    for (auto& collection : collections_) {
+        std::size_t n = collection.n_;
+
+        for (auto& column : collection.columns_) {
+            values_.resize(column.width_);
+            if (column.integer_) reserve(column.ints_, n*column.width_, column.branch_);
+            else reserve(column.doubles_, n*column.width_, column.branch_);
+            for (std::size_t i = 0; i < n; ++i) {
+                column.get_(collection.at_(i), values_.data());
+                for (int j = 0; j < column.width_; ++j) {
+                    if (column.integer_) column.ints_[i*column.width_ + j] = values_[j];
+                    else column.doubles_[i*column.width_ + j] = values_[j];
+                }
+            }
+        }
+
+        for (auto& link : collection.links_) {
+            if (!link.jagged_) {
+                reserve(link.index_, n, link.index_branch_);
+                for (std::size_t i = 0; i < n; ++i) {
+                    targets_.clear();
+                    link.targets_(collection.at_(i), targets_);
+                    link.index_[i] = targets_.empty() ? -1 : indexOf(targets_[0]);
+                }
+                continue;
+            }
+
+            reserve(link.begin_, n, link.begin_branch_);
+            reserve(link.count_, n, link.count_branch_);
+            link.total_ = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                // The stored indices are already positions in the linked collection
+                const std::vector<int>* stored = link.stored_ ? link.stored_(collection.at_(i)) : nullptr;
+                if (stored && !stored->empty()) {
+                    reserve(link.index_, link.total_ + stored->size(), link.index_branch_);
+                    link.begin_[i] = link.total_;
+                    link.count_[i] = stored->size();
+                    for (int index : *stored) link.index_[link.total_++] = index;
+                    continue;
+                }
+                targets_.clear();
+                link.targets_(collection.at_(i), targets_);
+                reserve(link.index_, link.total_ + targets_.size(), link.index_branch_);
+                link.begin_[i] = link.total_;
+                link.count_[i] = targets_.size();
+                for (auto target : targets_) link.index_[link.total_++] = indexOf(target);
+            }
+        }
+    }
+}
+
+Int_t ColumnarWriter::indexOf(TObject* object) const {
+    if (!object) return -1;
+    auto index = indices_.find(object);
+    return index == indices_.end() ? -1 : index->second;
+}
+
+void ColumnarWriter::makeBranches(Collection& collection) {
+
+    std::string count = "n" + collection.name_;
+    tree_->Branch(count.c_str(), &collection.n_, (count + "/I").c_str());
+
+    for (auto& column : collection.columns_) {
+        std::string name = collection.name_ + "_" + column.name_;
+        std::string leaves = name + "[" + count + "]";
+        if (column.width_ > 1) leaves += "[" + std::to_string(column.width_) + "]";
+        void* address{nullptr};
+        if (column.integer_) {
+            column.ints_.resize(column.width_);
+            address = column.ints_.data();
+            leaves += "/I";
+        } else {
+            column.doubles_.resize(column.width_);
+            address = column.doubles_.data();
+            leaves += "/D";
+        }
+        column.branch_ = tree_->Branch(name.c_str(), address, leaves.c_str());
+    }
+
+    for (auto& link : collection.links_) {
+        std::string name = collection.name_ + "_" + link.name_;
+        link.index_.resize(1);
+        if (!link.jagged_) {
+            link.index_branch_ = tree_->Branch(name.c_str(), link.index_.data(),
+                    (name + "[" + count + "]/I").c_str());
+            continue;
+        }
+        link.begin_.resize(1);
+        link.count_.resize(1);
+        link.begin_branch_ = tree_->Branch((name + "Begin").c_str(), link.begin_.data(),
+                (name + "Begin[" + count + "]/I").c_str());
+        link.count_branch_ = tree_->Branch((name + "Count").c_str(), link.count_.data(),
+                (name + "Count[" + count + "]/I").c_str());
+        std::string total = "n" + name;
+        tree_->Branch(total.c_str(), &link.total_, (total + "/I").c_str());
+        link.index_branch_ = tree_->Branch(name.c_str(), link.index_.data(),
+                (name + "[" + total + "]/I").c_str());
+    }
+}
+
+template <class T>
+void ColumnarWriter::addColumn(Collection& collection, const std::string& name,
+        std::function<double(T*)> get, bool integer) {
+    addColumns<T>(collection, name, 1,
+            [get](T* object, double* values) { values[0] = get(object); }, integer);
+}
+
+template <class T>
+void ColumnarWriter::addColumns(Collection& collection, const std::string& name, int width,
+        std::function<void(T*, double*)> get, bool integer) {
+    Column column;
+    column.name_ = name;
+    column.width_ = width;
+    column.integer_ = integer;
+    column.get_ = [get](TObject* object, double* values) { get(static_cast<T*>(object), values); };
+    collection.columns_.push_back(std::move(column));
+}
+
+template <class T>
+void ColumnarWriter::addLink(Collection& collection, const std::string& name,
+        std::function<TObject*(T*)> target) {
+    Link link;
+    link.name_ = name;
+    link.targets_ = [target](TObject* object, std::vector<TObject*>& targets) {
+        targets.push_back(target(static_cast<T*>(object)));
+    };
+    collection.links_.push_back(std::move(link));
+}
+
+template <class T>
+void ColumnarWriter::addLinks(Collection& collection, const std::string& name,
+        std::function<TRefArray*(T*)> array) {
+    Link link;
+    link.name_ = name;
+    link.jagged_ = true;
+    link.targets_ = [array](TObject* object, std::vector<TObject*>& targets) {
+        TRefArray* refs = array(static_cast<T*>(object));
+        if (!refs) return;
+        for (int i = 0; i < refs->GetEntriesFast(); ++i) targets.push_back(refs->At(i));
+    };
+    collection.links_.push_back(std::move(link));
+}
+
+template <class T>
+void ColumnarWriter::addLinks(Collection& collection, const std::string& name,
+        std::function<TRefArray*(T*)> array,
+        std::function<const std::vector<int>&(T*)> indices) {
+    addLinks<T>(collection, name, array);
+    collection.links_.back().stored_ = [indices](TObject* object) {
+        return &indices(static_cast<T*>(object));
+    };
+}
+
+void ColumnarWriter::addTrack(Collection& c) {
+    addColumn<Track>(c, "d0", [](Track* t) { return t->getD0(); });
+    addColumn<Track>(c, "phi0", [](Track* t) { return t->getPhi(); });
+    addColumn<Track>(c, "omega", [](Track* t) { return t->getOmega(); });
+    addColumn<Track>(c, "tanLambda", [](Track* t) { return t->getTanLambda(); });
+    addColumn<Track>(c, "z0", [](Track* t) { return t->getZ0(); });
+    addColumn<Track>(c, "chi2", [](Track* t) { return t->getChi2(); });
+    addColumn<Track>(c, "ndf", [](Track* t) { return t->getNdf(); });
+    addColumn<Track>(c, "time", [](Track* t) { return t->getTrackTime(); });
+    addColumn<Track>(c, "type", [](Track* t) { return t->getType(); }, true);
+    addColumn<Track>(c, "charge", [](Track* t) { return t->getCharge(); }, true);
+    addColumn<Track>(c, "nHits", [](Track* t) { return t->getTrackerHitCount(); }, true);
+    addColumn<Track>(c, "id", [](Track* t) { return t->getID(); }, true);
+    addColumns<Track>(c, "p", 3, [](Track* t, double* v) { copyValues(t->getMomentum(), 3, v); });
+    addColumns<Track>(c, "posAtEcal", 3, [](Track* t, double* v) { copyValues(t->getPositionAtEcal(), 3, v); });
+    addColumns<Track>(c, "cov", 15, [](Track* t, double* v) { copyValues(t->getCov(), 15, v); });
+    addLinks<Track>(c, "hits", [](Track* t) { return t->getSvtHits(); },
+            [](Track* t) -> const std::vector<int>& { return t->getHitIndices(); });
+}
+
+void ColumnarWriter::addTrackerHit(Collection& c) {
+    addColumns<TrackerHit>(c, "pos", 3, [](TrackerHit* h, double* v) { copyValues(h->getPosition(), 3, v); });
+    addColumns<TrackerHit>(c, "cov", 6, [](TrackerHit* h, double* v) { copyValues(h->getCovarianceMatrix(), 6, v); });
+    addColumn<TrackerHit>(c, "time", [](TrackerHit* h) { return h->getTime(); });
+    addColumn<TrackerHit>(c, "charge", [](TrackerHit* h) { return h->getCharge(); });
+    addColumn<TrackerHit>(c, "rawCharge", [](TrackerHit* h) { return h->getRawCharge(); });
+    addColumn<TrackerHit>(c, "layer", [](TrackerHit* h) { return h->getLayer(); }, true);
+    addColumn<TrackerHit>(c, "volume", [](TrackerHit* h) { return h->getVolume(); }, true);
+    addColumn<TrackerHit>(c, "id", [](TrackerHit* h) { return h->getID(); }, true);
+    addLinks<TrackerHit>(c, "rawHits", [](TrackerHit* h) { return h->getRawHits(); },
+            [](TrackerHit* h) -> const std::vector<int>& { return h->getRawHitIndices(); });
+}
+
+void ColumnarWriter::addRawSvtHit(Collection& c) {
+    addColumn<RawSvtHit>(c, "layer", [](RawSvtHit* h) { return h->getLayer(); }, true);
+    addColumn<RawSvtHit>(c, "module", [](RawSvtHit* h) { return h->getModule(); }, true);
+    addColumn<RawSvtHit>(c, "sensor", [](RawSvtHit* h) { return h->getSensor(); }, true);
+    addColumn<RawSvtHit>(c, "side", [](RawSvtHit* h) { return h->getSide(); }, true);
+    addColumn<RawSvtHit>(c, "strip", [](RawSvtHit* h) { return h->getStrip(); }, true);
+    addColumns<RawSvtHit>(c, "adc", 6, [](RawSvtHit* h, double* v) {
+        for (int i = 0; i < 6; ++i) v[i] = h->getADCs()[i];
+    }, true);
+    addColumn<RawSvtHit>(c, "fitN", [](RawSvtHit* h) { return h->getFitN(); }, true);
+    addColumns<RawSvtHit>(c, "t0", 2, [](RawSvtHit* h, double* v) {
+        for (int i = 0; i < 2; ++i) v[i] = h->getT0(i);
+    });
+    addColumns<RawSvtHit>(c, "amp", 2, [](RawSvtHit* h, double* v) {
+        for (int i = 0; i < 2; ++i) v[i] = h->getAmp(i);
+    });
+    addColumns<RawSvtHit>(c, "chi2", 2, [](RawSvtHit* h, double* v) {
+        for (int i = 0; i < 2; ++i) v[i] = h->getChiSq(i);
+    });
+}
+
+void ColumnarWriter::addCalHit(Collection& c) {
+    addColumn<CalHit>(c, "energy", [](CalHit* h) { return h->getEnergy(); });
+    addColumn<CalHit>(c, "time", [](CalHit* h) { return h->getTime(); });
+    addColumns<CalHit>(c, "index", 2, [](CalHit* h, double* v) {
+        copyValues(h->getCrystalIndices(), 2, v);
+    }, true);
+}
+
+void ColumnarWriter::addCalCluster(Collection& c) {
+    addColumns<CalCluster>(c, "pos", 3, [](CalCluster* cl, double* v) { copyValues(cl->getPosition(), 3, v); });
+    addColumn<CalCluster>(c, "energy", [](CalCluster* cl) { return cl->getEnergy(); });
+    addColumn<CalCluster>(c, "time", [](CalCluster* cl) { return cl->getTime(); });
+    addColumn<CalCluster>(c, "nHits", [](CalCluster* cl) { return cl->getNHits(); }, true);
+    addLink<CalCluster>(c, "seed", [](CalCluster* cl) { return cl->getSeed(); });
+    addLinks<CalCluster>(c, "hits", [](CalCluster* cl) { return cl->getHits(); });
+}
+
+void ColumnarWriter::addVertex(Collection& c) {
+    addColumns<Vertex>(c, "pos", 3, [](Vertex* vtx, double* v) {
+        v[0] = vtx->getX();
+        v[1] = vtx->getY();
+        v[2] = vtx->getZ();
+    });
+    addColumns<Vertex>(c, "cov", 6, [](Vertex* vtx, double* v) { copyValues(vtx->getCovariance(), 6, v); });
+    addColumn<Vertex>(c, "chi2", [](Vertex* vtx) { return vtx->getChi2(); });
+    addColumn<Vertex>(c, "probability", [](Vertex* vtx) { return vtx->getProbability(); });
+    addColumn<Vertex>(c, "invMass", [](Vertex* vtx) { return vtx->getInvMass(); });
+    addLinks<Vertex>(c, "parts", [](Vertex* vtx) { return vtx->getParticles(); },
+            [](Vertex* vtx) -> const std::vector<int>& { return vtx->getParticleIndices(); });
+}
+
+void ColumnarWriter::addParticle(Collection& c) {
+    addColumn<Particle>(c, "charge", [](Particle* p) { return p->getCharge(); }, true);
+    addColumn<Particle>(c, "type", [](Particle* p) { return p->getType(); }, true);
+    addColumn<Particle>(c, "pdg", [](Particle* p) { return p->getPDG(); }, true);
+    addColumn<Particle>(c, "energy", [](Particle* p) { return p->getEnergy(); });
+    addColumn<Particle>(c, "mass", [](Particle* p) { return p->getMass(); });
+    addColumn<Particle>(c, "goodnessOfPID", [](Particle* p) { return p->getGoodnessOfPID(); });
+    addColumns<Particle>(c, "p", 3, [](Particle* p, double* v) { copyValues(p->getMomentum(), 3, v); });
+    // The track and cluster are stored in the particle rather than referenced
+    addColumns<Particle>(c, "trackParameters", 5, [](Particle* p, double* v) {
+        copyValues(p->getTrack().getTrackParameters(), 5, v);
+    });
+    addColumns<Particle>(c, "cluster", 2, [](Particle* p, double* v) {
+        CalCluster cluster = p->getCluster();
+        v[0] = cluster.getEnergy();
+        v[1] = cluster.getTime();
+    });
+}
+
+void ColumnarWriter::addMCParticle(Collection& c) {
+    addColumn<MCParticle>(c, "id", [](MCParticle* p) { return p->getID(); }, true);
+    addColumn<MCParticle>(c, "pdg", [](MCParticle* p) { return p->getPDG(); }, true);
+    addColumn<MCParticle>(c, "momPDG", [](MCParticle* p) { return p->getMomPDG(); }, true);
+    addColumn<MCParticle>(c, "charge", [](MCParticle* p) { return p->getCharge(); }, true);
+    addColumn<MCParticle>(c, "genStatus", [](MCParticle* p) { return p->getGenStatus(); }, true);
+    addColumn<MCParticle>(c, "simStatus", [](MCParticle* p) { return p->getSimStatus(); }, true);
+    addColumn<MCParticle>(c, "energy", [](MCParticle* p) { return p->getEnergy(); });
+    addColumn<MCParticle>(c, "mass", [](MCParticle* p) { return p->getMass(); });
+    addColumn<MCParticle>(c, "time", [](MCParticle* p) { return p->getTime(); });
+    addColumns<MCParticle>(c, "p", 3, [](MCParticle* p, double* v) { copyValues(p->getMomentum(), 3, v); });
+    addColumns<MCParticle>(c, "vertex", 3, [](MCParticle* p, double* v) { copyValues(p->getVertexPosition(), 3, v); });
+    addColumns<MCParticle>(c, "endPoint", 3, [](MCParticle* p, double* v) { copyValues(p->getEndPoint(), 3, v); });
+    addLinks<MCParticle>(c, "daughters", [](MCParticle* p) { return p->getDaughters(); });
+}
@@ -25,18 +25,47 @@ static std::string stringMember(PyObject* owner, const std::string& name) {
 }
 
 
-static long intMember(PyObject* owner, const std::string& name) {
+static long intMember(PyObject* owner, const std::string& name, long defaultValue = 0) {
     
-    long retval;
+    long retval = defaultValue;
     PyObject* temp = PyObject_GetAttrString(owner, name.c_str());
     if (temp != 0) {
         retval = PyLong_AsLong(temp);
         Py_DECREF(temp);
+    } else {
+        PyErr_Clear();
     }
     return retval;
 }
 
 
+static std::vector<std::string> stringListMember(PyObject* owner, const std::string& name) {
+
+    std::vector<std::string> retval;
+    PyObject* temp = PyObject_GetAttrString(owner, name.c_str());
+    if (temp == 0) {
+        PyErr_Clear();
+        return retval;
+    }
+    if (!PyList_Check(temp)) {
+        Py_DECREF(temp);
+        throw std::runtime_error("[ ConfigurePython ]: " + name + " is not a python list as expected."); 
+    }
+    for (Py_ssize_t i = 0; i < PyList_Size(temp); i++) {
+        PyObject* elem = PyList_GetItem(temp, i);
+#if PY_MAJOR_VERSION >= 3
+        PyObject* pyStr = PyUnicode_AsEncodedString(elem, "utf-8","Error ~");
+        retval.push_back(PyBytes_AS_STRING(pyStr));
+        Py_XDECREF(pyStr);
+#else
+        retval.push_back(PyString_AsString(elem));
+#endif
+    }
+    Py_DECREF(temp);
+    return retval;
+}
+
+
 ConfigurePython::ConfigurePython(const std::string& python_script, char* args[], int nargs) {
 
     std::string path(".");
@@ -129,12 +158,156 @@ ConfigurePython::ConfigurePython(const std::string& python_script, char* args[],
 
     event_limit_ = intMember(p_process, "max_events");
     run_mode_    = intMember(p_process, "run_mode");
+    threads_     = intMember(p_process, "threads", 1);
+    first_event_ = intMember(p_process, "first_event", 0);
+    build_index_ = intMember(p_process, "build_index", 0);
+    event_list_  = stringMember(p_process, "event_list");
+    if (event_list_.empty()) 
+        PyErr_Clear();
+    last_event_  = intMember(p_process, "last_event", -1);
+    shard_index_ = intMember(p_process, "shard_index", 0);
+    n_shards_    = intMember(p_process, "n_shards", 1);
+    shard_mode_  = stringMember(p_process, "shard_mode");
+    if (shard_mode_.empty()) 
+        PyErr_Clear();
+    else if (shard_mode_ != "contiguous" && shard_mode_ != "modulo")
+        throw std::runtime_error("[ ConfigurePython ]: Unknown shard mode " + shard_mode_); 
+    if (n_shards_ < 1 || shard_index_ < 0 || shard_index_ >= n_shards_)
+        throw std::runtime_error("[ ConfigurePython ]: Invalid shard " + std::to_string(shard_index_) 
+                + " of " + std::to_string(n_shards_)); 
+    workers_     = intMember(p_process, "workers", 1);
+    timing_      = intMember(p_process, "timing", 1);
+    memory_profile_ = intMember(p_process, "memory_profile", 0);
+    read_ahead_  = intMember(p_process, "read_ahead", 0);
+    concurrent_processors_ = intMember(p_process, "concurrent_processors", 1);
+    write_threads_ = intMember(p_process, "write_threads", 0);
+    write_buffer_  = intMember(p_process, "write_buffer", 30000000);
+    auto_flush_    = intMember(p_process, "auto_flush", 0);
+
+    PyObject* p_profiles = PyObject_GetAttrString(p_process, "branch_profiles");
+    if (p_profiles == 0) {
+        PyErr_Clear();
+    } else {
+        if (!PyList_Check(p_profiles)) {
+            throw std::runtime_error("[ ConfigurePython ]: Branch profiles is not a python list as expected."); 
+        }
+        for (Py_ssize_t i = 0; i < PyList_Size(p_profiles); i++) {
+            PyObject* p_profile = PyList_GetItem(p_profiles, i);
+            BranchProfile profile;
+            profile.branches_    = stringMember(p_profile, "branches");
+            profile.algorithm_   = stringMember(p_profile, "compression");
+            profile.level_       = intMember(p_profile, "level", -1);
+            profile.basket_size_ = intMember(p_profile, "basket_size", -1);
+            profile.split_level_ = intMember(p_profile, "split_level", -1);
+            branch_profiles_.push_back(profile);
+        }
+        Py_DECREF(p_profiles);
+    }
+    columnar_             = intMember(p_process, "columnar", 0);
+    columnar_collections_ = stringListMember(p_process, "columnar_collections");
+    skim_                 = intMember(p_process, "skim", 0);
+    skim_branches_        = stringListMember(p_process, "skim_branches");
+    active_branches_only_ = intMember(p_process, "active_branches_only", 0);
+    extra_branches_       = stringListMember(p_process, "extra_branches");
+    lazy_branches_        = stringListMember(p_process, "lazy_branches");
+    cache_size_           = intMember(p_process, "cache_size", -1);
+    cache_learn_entries_  = intMember(p_process, "cache_learn_entries", 0);
+    cache_branches_       = stringListMember(p_process, "cache_branches");
+    async_prefetch_       = intMember(p_process, "async_prefetch", 0);
 
     PyObject* p_sequence = PyObject_GetAttrString(p_process, "sequence");
     if (!PyList_Check(p_sequence)) {
         throw std::runtime_error("[ ConfigurePython ]: Sequence is not a python list as expected."); 
     }
     
+    sequence_ = readSequence(p_sequence);
+    Py_DECREF(p_sequence);
+
+    PyObject* p_wagons = PyObject_GetAttrString(p_process, "wagons");
+    if (p_wagons == 0) {
+        PyErr_Clear();
+    } else {
+        if (!PyList_Check(p_wagons)) {
+            throw std::runtime_error("[ ConfigurePython ]: Wagons is not a python list as expected."); 
+        }
+        for (Py_ssize_t i = 0; i < PyList_Size(p_wagons); i++) {
+            PyObject* p_wagon = PyList_GetItem(p_wagons, i);
+            WagonInfo wagon;
+            wagon.name_ = stringMember(p_wagon, "name");
+            wagon.output_files_ = stringListMember(p_wagon, "output_files");
+            PyObject* p_wagon_sequence = PyObject_GetAttrString(p_wagon, "sequence");
+            if (p_wagon_sequence == 0 || !PyList_Check(p_wagon_sequence)) {
+                throw std::runtime_error("[ ConfigurePython ]: Sequence of wagon " + wagon.name_ 
+                        + " is not a python list as expected."); 
+            }
+            wagon.sequence_ = readSequence(p_wagon_sequence);
+            Py_DECREF(p_wagon_sequence);
+            wagons_.push_back(wagon);
+        }
+        Py_DECREF(p_wagons);
+    }
+
+    py_list = PyObject_GetAttrString(p_process, "input_files");
+    if (!PyList_Check(py_list)) {
+        throw std::runtime_error("[ ConfigurePython ]: Input files is not a python list as expected."); 
+        return;
+    }
+    for (Py_ssize_t i = 0; i < PyList_Size(py_list); i++) {
+        PyObject* elem = PyList_GetItem(py_list, i);
+#if PY_MAJOR_VERSION >= 3
+        PyObject* pyStr = PyUnicode_AsEncodedString(elem, "utf-8","Error ~");
+        input_files_.push_back(PyBytes_AS_STRING(pyStr));
+        Py_XDECREF(pyStr);
+#else
+        input_files_.push_back(PyString_AsString(elem));
+#endif
+    }
+
+    Py_DECREF(py_list);
+
+    py_list = PyObject_GetAttrString(p_process, "output_files");
+    if (!PyList_Check(py_list)) {
+        throw std::runtime_error("[ ConfigurePython ]: Output files is not a python list as expected."); 
+        return;
+    }
+    for (Py_ssize_t i = 0; i < PyList_Size(py_list); i++) {
+        PyObject* elem = PyList_GetItem(py_list, i);
+#if PY_MAJOR_VERSION >= 3
+        PyObject* pyStr = PyUnicode_AsEncodedString(elem, "utf-8","Error ~");
+        output_files_.push_back(PyBytes_AS_STRING(pyStr));
+        Py_XDECREF(pyStr);
+#else
+        output_files_.push_back(PyString_AsString(elem));
+#endif
+    }
+    Py_DECREF(py_list);
+
+    py_list = PyObject_GetAttrString(p_process, "libraries");
+    if (!PyList_Check(py_list)) {
+        throw std::runtime_error("[ ConfigurePython ]: libraries is not a python list as expected."); 
+        return;
+    }
+    for (Py_ssize_t i = 0; i < PyList_Size(py_list); i++) {
+        PyObject* elem = PyList_GetItem(py_list, i);
+#if PY_MAJOR_VERSION >= 3
+        PyObject* pyStr = PyUnicode_AsEncodedString(elem, "utf-8","Error ~");
+        libraries_.push_back(PyBytes_AS_STRING(pyStr));
+        Py_XDECREF(pyStr);
+#else
+      libraries_.push_back(PyString_AsString(elem));
+#endif
+    }
+    Py_DECREF(py_list);
+
+    } catch (std::exception& e) { 
+        std::cout << e.what() << std::endl;
+    }
+
+}
+
+std::vector<ConfigurePython::ProcessorInfo> ConfigurePython::readSequence(PyObject* p_sequence) {
+
+    std::vector<ProcessorInfo> sequence;
     for (Py_ssize_t i = 0; i < PyList_Size(p_sequence); i++) {
         PyObject* processor = PyList_GetItem(p_sequence, i);
         ProcessorInfo pi;
@@ -230,66 +403,9 @@ ConfigurePython::ConfigurePython(const std::string& python_script, char* args[],
             }
         }
 
-        sequence_.push_back(pi);
-    }
-    Py_DECREF(p_sequence);
-
-    py_list = PyObject_GetAttrString(p_process, "input_files");
-    if (!PyList_Check(py_list)) {
-        throw std::runtime_error("[ ConfigurePython ]: Input files is not a python list as expected."); 
-        return;
-    }
-    for (Py_ssize_t i = 0; i < PyList_Size(py_list); i++) {
-        PyObject* elem = PyList_GetItem(py_list, i);
-#if PY_MAJOR_VERSION >= 3
-        PyObject* pyStr = PyUnicode_AsEncodedString(elem, "utf-8","Error ~");
-        input_files_.push_back(PyBytes_AS_STRING(pyStr));
-        Py_XDECREF(pyStr);
-#else
-        input_files_.push_back(PyString_AsString(elem));
-#endif
-    }
-
-    Py_DECREF(py_list);
-
-    py_list = PyObject_GetAttrString(p_process, "output_files");
-    if (!PyList_Check(py_list)) {
-        throw std::runtime_error("[ ConfigurePython ]: Output files is not a python list as expected."); 
-        return;
-    }
-    for (Py_ssize_t i = 0; i < PyList_Size(py_list); i++) {
-        PyObject* elem = PyList_GetItem(py_list, i);
-#if PY_MAJOR_VERSION >= 3
-        PyObject* pyStr = PyUnicode_AsEncodedString(elem, "utf-8","Error ~");
-        output_files_.push_back(PyBytes_AS_STRING(pyStr));
-        Py_XDECREF(pyStr);
-#else
-        output_files_.push_back(PyString_AsString(elem));
-#endif
-    }
-    Py_DECREF(py_list);
-
-    py_list = PyObject_GetAttrString(p_process, "libraries");
-    if (!PyList_Check(py_list)) {
-        throw std::runtime_error("[ ConfigurePython ]: libraries is not a python list as expected."); 
-        return;
-    }
-    for (Py_ssize_t i = 0; i < PyList_Size(py_list); i++) {
-        PyObject* elem = PyList_GetItem(py_list, i);
-#if PY_MAJOR_VERSION >= 3
-        PyObject* pyStr = PyUnicode_AsEncodedString(elem, "utf-8","Error ~");
-        libraries_.push_back(PyBytes_AS_STRING(pyStr));
-        Py_XDECREF(pyStr);
-#else
-      libraries_.push_back(PyString_AsString(elem));
-#endif
-    }
-    Py_DECREF(py_list);
-
-    } catch (std::exception& e) { 
-        std::cout << e.what() << std::endl;
+        sequence.push_back(pi);
     }
-
+    return sequence;
 }
 
 ConfigurePython::~ConfigurePython() {
@@ -310,6 +426,20 @@ Process* ConfigurePython::makeProcess() {
         }
         ep->configure(proc.params_);
         p->addToSequence(ep);    
+        p->addProcessorConfig(proc.classname_, proc.instancename_, proc.params_);
+    }
+
+    for (auto& wagon : wagons_) {
+        std::vector<Processor*> sequence;
+        for (auto proc : wagon.sequence_) {
+            Processor* ep = ProcessorFactory::instance().createProcessor(proc.classname_, proc.instancename_, *p);
+            if (ep == 0) {
+                throw std::runtime_error("[ ConfigurePython ]: Unable to create instance of " + proc.instancename_); 
+            }
+            ep->configure(proc.params_);
+            sequence.push_back(ep);
+        }
+        p->addWagon(wagon.name_, sequence, wagon.output_files_);
     }
         
     for (auto file : input_files_) {
@@ -321,7 +451,44 @@ Process* ConfigurePython::makeProcess() {
     }
 
     p->setEventLimit(event_limit_);
+    p->setEventRange(first_event_, last_event_);
+    p->setEventList(event_list_);
+    p->setBuildIndex(build_index_);
+    p->setShard(shard_index_, n_shards_, shard_mode_ == "modulo");
     p->setRunMode(run_mode_);
+    p->setThreads(threads_);
+    p->setWorkers(workers_);
+    p->setTiming(timing_);
+    p->setMemoryProfile(memory_profile_);
+    p->setReadAhead(read_ahead_);
+    p->setConcurrentProcessors(concurrent_processors_);
+    p->setWriteThreads(write_threads_);
+    p->setWriteBuffer(write_buffer_);
+    p->setAutoFlush(auto_flush_);
+    for (auto& profile : branch_profiles_) {
+        p->addBranchProfile(profile);
+    }
+    p->setColumnar(columnar_);
+    for (auto collection : columnar_collections_) {
+        p->addColumnarCollection(collection);
+    }
+    p->setSkim(skim_);
+    for (auto branch : skim_branches_) {
+        p->addSkimBranch(branch);
+    }
+    p->setActiveBranchesOnly(active_branches_only_);
+    for (auto branch : extra_branches_) {
+        p->addExtraBranch(branch);
+    }
+    for (auto branch : lazy_branches_) {
+        p->addLazyBranch(branch);
+    }
+    p->setCacheSize(cache_size_);
+    p->setCacheLearnEntries(cache_learn_entries_);
+    for (auto branch : cache_branches_) {
+        p->addCacheBranch(branch);
+    }
+    p->setAsyncPrefetch(async_prefetch_);
 
     return p; 
 }
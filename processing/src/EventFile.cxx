@@ -6,29 +6,74 @@
 
 #include "EventFile.h"
 
+#include <Compression.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+#include <fnmatch.h>
+
 EventFile::EventFile(const std::string ifilename, const std::string& ofilename) { 
 
     // Open the input LCIO file. If the input file can't be opened, throw an 
     // exception. 
     lc_reader_->open(ifilename); 
+    ifilename_ = ifilename;
 
     // Open the output ROOT file
     ofile_ = new TFile(ofilename.c_str(), "recreate");
+    ofilename_ = ofilename;
 }
 
-EventFile::~EventFile() {}
+EventFile::~EventFile() {
+    stopReader();
+    delete index_;
+    delete columnar_;
+}
 
 // Close out the previous event before moving on.
 void EventFile::FillEvent() {
     if (entry_ > 0) {
+        if (columnar_) columnar_->fill();
         event_->getTree()->Fill();
+        if (index_) 
+            index_->add(lc_event_->getRunNumber(), lc_event_->getEventNumber(), 
+                    event_->getTree()->GetEntries() - 1);
     }
 }
 
 bool EventFile::nextEvent() { 
 
-    // Read the next event.  If it doesn't exist, stop processing events.
-    if ((lc_event_ = lc_reader_->readNextEvent())  == 0) return false;
+    if (read_ahead_ > 0) {
+        if (slots_.empty()) startReader();
+
+        std::unique_lock<std::mutex> lock(slots_mutex_);
+
+        // The previous event has been filled, its slot can be recycled
+        if (current_slot_ >= 0) {
+            slots_[current_slot_].ready = false;
+            slots_cv_.notify_all();
+        }
+        current_slot_ = (current_slot_ + 1) % slots_.size();
+
+        ReadSlot& slot = slots_[current_slot_];
+        slots_cv_.wait(lock, [&slot] { return slot.ready; });
+        if (!reader_error_.empty())
+            throw std::runtime_error("[ EventFile ]: Error reading " + ifilename_ + ": " + reader_error_);
+        if (slot.end) return false;
+        lc_event_ = slot.event;
+    } 
+    else { 
+        // Skip the events outside of the selected range
+        Long64_t index = first_event_ + entry_*stride_;
+        if (last_event_ >= 0 && index >= last_event_) return false;
+        if (index > read_index_) lc_reader_->skipNEvents(index - read_index_);
+        read_index_ = index + 1;
+
+        // Read the next event.  If it doesn't exist, stop processing events.
+        if ((lc_event_ = lc_reader_->readNextEvent())  == 0) return false;
+    }
     
     event_->setLCEvent(lc_event_); 
     event_->setEntry(entry_); 
@@ -45,15 +90,186 @@ void EventFile::resetOutputFileDir() {
   ofile_->cd();
 }
 
+void EventFile::applyBranchProfiles(const std::vector<BranchProfile>& profiles) {
+
+    TTree* tree = event_->getTree();
+    TObjArray* branches = tree->GetListOfBranches();
+    for (auto& profile : profiles) { 
+
+        int algorithm = -1;
+        if (profile.algorithm_ == "ZLIB") algorithm = ROOT::kZLIB;
+        else if (profile.algorithm_ == "LZMA") algorithm = ROOT::kLZMA;
+        else if (profile.algorithm_ == "LZ4") algorithm = ROOT::kLZ4;
+        else if (profile.algorithm_ == "ZSTD") algorithm = ROOT::kZSTD;
+        else if (!profile.algorithm_.empty()) 
+            throw std::runtime_error("[ EventFile ]: Unknown compression algorithm " + profile.algorithm_);
+
+        int nmatched = 0;
+        for (int ib = 0; ib < branches->GetEntriesFast(); ++ib) { 
+            TBranch* branch = static_cast<TBranch*>(branches->At(ib));
+            if (fnmatch(profile.branches_.c_str(), branch->GetName(), 0) != 0) continue;
+            ++nmatched;
+
+            // Both settings are propagated to the sub-branches
+            if (algorithm >= 0) {
+                int level = profile.level_ >= 0 ? profile.level_ : ofile_->GetCompressionLevel();
+                branch->SetCompressionSettings(algorithm*100 + level);
+            } else if (profile.level_ >= 0) {
+                branch->SetCompressionLevel(profile.level_);
+            }
+            if (profile.basket_size_ > 0) 
+                tree->SetBasketSize((std::string(branch->GetName()) + "*").c_str(), profile.basket_size_);
+
+            // The split level is fixed when the branch is created, i.e. by Processor::addBranch
+            if (profile.split_level_ >= 0 && branch->InheritsFrom("TBranchElement") 
+                    && branch->GetSplitLevel() != profile.split_level_)
+                std::cout << "[ EventFile ]: WARNING: Branch " << branch->GetName() << " has split level " 
+                    << branch->GetSplitLevel() << " instead of " << profile.split_level_ 
+                    << ", it wasn't created with the split level of the profiles" << std::endl;
+        }
+
+        if (nmatched == 0) 
+            std::cout << "[ EventFile ]: No output branch matches " << profile.branches_ << std::endl;
+    }
+}
+
+void EventFile::printBranchSizes() {
+
+    TObjArray* branches = event_->getTree()->GetListOfBranches();
+    std::cout << "[ EventFile ]: Output branch sizes" << std::endl;
+    std::cout << std::left << std::setw(32) << "Branch" << std::right 
+        << std::setw(14) << "Total [B]" << std::setw(14) << "Zipped [B]" 
+        << std::setw(10) << "Ratio" << std::setw(8) << "Comp." << std::endl;
+    for (int ib = 0; ib < branches->GetEntriesFast(); ++ib) { 
+        TBranch* branch = static_cast<TBranch*>(branches->At(ib));
+        Long64_t tot = branch->GetTotBytes("*");
+        Long64_t zip = branch->GetZipBytes("*");
+        std::cout << std::left << std::setw(32) << branch->GetName() << std::right 
+            << std::setw(14) << tot << std::setw(14) << zip 
+            << std::setw(10) << std::fixed << std::setprecision(2) << (zip > 0 ? double(tot)/zip : 0.) 
+            << std::setw(8) << branch->GetCompressionSettings() << std::endl;
+    }
+}
+
+void EventFile::setEventRange(Long64_t first, Long64_t last, Long64_t stride) {
+    first_event_ = std::max(first, (Long64_t)0);
+    last_event_ = last;
+    stride_ = std::max(stride, (Long64_t)1);
+}
+
+void EventFile::setupColumnar(const std::vector<std::string>& collections) {
+    delete columnar_;
+    columnar_ = new ColumnarWriter(event_->getTree(), collections);
+    std::cout << "[ EventFile ]: Writing the columns of " 
+        << columnar_->getNumberOfCollections() << " collections" << std::endl;
+}
+
+void EventFile::setBuildIndex(bool build_index) {
+    delete index_;
+    index_ = build_index ? new EventIndex() : nullptr;
+}
+
+Long64_t EventFile::getNumberOfEvents() {
+    return lc_reader_->getNumberOfEvents();
+}
+
+void EventFile::setReadAhead(int read_ahead) {
+    read_ahead_ = std::max(read_ahead, 0);
+}
+
+void EventFile::startReader() {
+
+    // The main reader becomes the first slot, the others read the 
+    // same file, each one starting one event further.
+    slots_.resize(read_ahead_ + 1);
+    slots_[0].reader = lc_reader_;
+    for (unsigned int islot = 1; islot < slots_.size(); ++islot) {
+        slots_[islot].reader = IOIMPL::LCFactory::getInstance()->createLCReader();
+        slots_[islot].reader->open(ifilename_);
+    }
+
+    stop_reader_ = false;
+    current_slot_ = -1;
+    reader_thread_ = std::thread(&EventFile::readAhead, this);
+}
+
+void EventFile::readAhead() {
+
+    int nslots = slots_.size();
+    for (Long64_t ordinal = 0; ; ++ordinal) {
+        ReadSlot& slot = slots_[ordinal % nslots];
+
+        // Wait for the consumer to release the slot
+        {
+            std::unique_lock<std::mutex> lock(slots_mutex_);
+            slots_cv_.wait(lock, [this, &slot] { return stop_reader_ || !slot.ready; });
+            if (stop_reader_) return;
+        }
+
+        // Each reader decodes every nslots-th selected event of the file
+        EVENT::LCEvent* event{nullptr};
+        std::string error;
+        try {
+            Long64_t index = first_event_ + ordinal*stride_;
+            if (last_event_ < 0 || index < last_event_) { 
+                if (index > slot.read_index) slot.reader->skipNEvents(index - slot.read_index);
+                slot.read_index = index + 1;
+                event = slot.reader->readNextEvent();
+            }
+        } catch (std::exception& e) {
+            error = e.what();
+        }
+
+        std::lock_guard<std::mutex> lock(slots_mutex_);
+        slot.event = event;
+        slot.end = (event == nullptr);
+        slot.ready = true;
+        if (!error.empty()) reader_error_ = error;
+        slots_cv_.notify_all();
+
+        // No event follows the end of the file
+        if (slot.end) return;
+    }
+}
+
+void EventFile::stopReader() {
+
+    if (slots_.empty()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(slots_mutex_);
+        stop_reader_ = true;
+        slots_cv_.notify_all();
+    }
+    if (reader_thread_.joinable()) reader_thread_.join();
+
+    // The first slot uses the main reader, which is closed with the file
+    for (unsigned int islot = 1; islot < slots_.size(); ++islot) {
+        slots_[islot].reader->close();
+        delete slots_[islot].reader;
+    }
+    slots_.clear();
+}
+
 void EventFile::close() { 
     
+    stopReader();
+
     // Close the LCIO file that was being processed
     lc_reader_->close();
 
-    // Write the ROOT tree to disk
+    // Write the ROOT tree to disk, waiting for the baskets still being 
+    // compressed in the background
     ofile_->cd();
+    event_->getTree()->FlushBaskets();
     event_->getTree()->Write();  
+    printBranchSizes();
+    if (index_) 
+        index_->setSource(event_->getTree()->GetEntries(), ofile_->GetUUID().AsString());
     
     // Close the ROOT file
     ofile_->Close(); 
+
+    if (index_ && !index_->write(EventIndex::indexFileName(ofilename_)))
+        std::cout << "[ EventFile ]: Unable to write the index of " << ofilename_ << std::endl;
 }
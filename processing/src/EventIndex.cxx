@@ -0,0 +1,176 @@
+/**
+ * @file EventIndex.cxx
+ * @brief Class mapping the run and event numbers of a DST to the entries 
+ *        of its event tree.
+ */
+
+#include "EventIndex.h"
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+//----------//
+//   ROOT   //
+//----------//
+#include "TFile.h"
+#include "TNamed.h"
+#include "TParameter.h"
+#include "TSystem.h"
+
+//-----------//
+//   hpstr   //
+//-----------//
+#include "EventHeader.h"
+
+std::string EventIndex::indexFileName(const std::string& dst) {
+    return dst + ".index.root";
+}
+
+EventIndex EventIndex::load(const std::string& dst) {
+    TDirectory* current = gDirectory;
+    std::unique_ptr<TFile> file(TFile::Open(dst.c_str()));
+    if (!file || file->IsZombie()) {
+        current->cd();
+        throw std::runtime_error("[ EventIndex ]: Unable to open " + dst);
+    }
+    TTree* tree = (TTree*)file->Get("HPS_Event");
+    if (!tree) {
+        current->cd();
+        throw std::runtime_error("[ EventIndex ]: HPS_Event tree not found in " + dst);
+    }
+    Long64_t nentries = tree->GetEntries();
+    std::string uuid = file->GetUUID().AsString();
+
+    EventIndex index;
+    std::string filename = indexFileName(dst);
+    if (!gSystem->AccessPathName(filename.c_str()) && index.read(filename)) {
+        if (index.matches(nentries, uuid)) {
+            file->Close();
+            current->cd();
+            return index;
+        }
+        std::cout << "---- [ hpstr ][ EventIndex ]: " << filename << " doesn't match " << dst << std::endl;
+    }
+
+    std::cout << "---- [ hpstr ][ EventIndex ]: Building index of " << dst << std::endl;
+    try {
+        index.build(tree);
+    } catch (...) {
+        current->cd();
+        throw;
+    }
+    index.setSource(nentries, uuid);
+    file->Close();
+    current->cd();
+
+    // The DST may be in a read only location, the index is still usable
+    if (!index.write(filename))
+        std::cout << "---- [ hpstr ][ EventIndex ]: Unable to write " << filename << std::endl;
+    return index;
+}
+
+void EventIndex::add(int run, int event, Long64_t entry) {
+    entries_[key(run, event)] = entry;
+}
+
+void EventIndex::build(TTree* tree, const std::string& header) {
+    TBranch* branch = tree->GetBranch(header.c_str());
+    if (!branch)
+        throw std::runtime_error("[ EventIndex ]: Branch " + header + " not found.");
+
+    // Only the event header is read
+    EventHeader* evth = nullptr;
+    branch->SetAddress(&evth);
+    Long64_t nentries = tree->GetEntries();
+    entries_.clear();
+    entries_.reserve(nentries);
+    for (Long64_t entry = 0; entry < nentries; ++entry) {
+        branch->GetEntry(entry);
+        add(evth->getRunNumber(), evth->getEventNumber(), entry);
+    }
+    branch->ResetAddress();
+    delete evth;
+}
+
+Long64_t EventIndex::find(int run, int event) const {
+    auto it = entries_.find(key(run, event));
+    return it == entries_.end() ? -1 : it->second;
+}
+
+bool EventIndex::read(const std::string& filename) {
+    TDirectory* current = gDirectory;
+    std::unique_ptr<TFile> file(TFile::Open(filename.c_str()));
+    if (!file || file->IsZombie()) {
+        current->cd();
+        return false;
+    }
+    TTree* tree = (TTree*)file->Get("EventIndex");
+    if (!tree) {
+        current->cd();
+        return false;
+    }
+
+    Int_t run = 0, event = 0;
+    Long64_t entry = 0;
+    tree->SetBranchAddress("run", &run);
+    tree->SetBranchAddress("event", &event);
+    tree->SetBranchAddress("entry", &entry);
+    entries_.clear();
+    entries_.reserve(tree->GetEntries());
+    for (Long64_t ientry = 0; ientry < tree->GetEntries(); ++ientry) {
+        tree->GetEntry(ientry);
+        add(run, event, entry);
+    }
+
+    // Missing in the indices written before the source was stored
+    std::unique_ptr<TObject> nentries(file->Get("HPS_Event_entries"));
+    std::unique_ptr<TObject> uuid(file->Get("HPS_Event_uuid"));
+    auto* nentries_par = dynamic_cast<TParameter<Long64_t>*>(nentries.get());
+    nentries_ = nentries_par ? nentries_par->GetVal() : -1;
+    uuid_ = uuid ? uuid->GetTitle() : "";
+    file->Close();
+    current->cd();
+    return true;
+}
+
+bool EventIndex::write(const std::string& filename) const {
+    TDirectory* current = gDirectory;
+    std::unique_ptr<TFile> file(TFile::Open(filename.c_str(), "RECREATE"));
+    if (!file || file->IsZombie()) {
+        current->cd();
+        return false;
+    }
+
+    // Store the events in entry order
+    std::vector<std::pair<Long64_t, uint64_t> > events;
+    events.reserve(entries_.size());
+    for (auto& entry : entries_)
+        events.push_back(std::make_pair(entry.second, entry.first));
+    std::sort(events.begin(), events.end());
+
+    Int_t run = 0, event = 0;
+    Long64_t entry = 0;
+    // The tree is owned, and deleted, by the file
+    TTree* tree = new TTree("EventIndex", "Run and event number of the HPS_Event entries");
+    tree->Branch("run", &run, "run/I");
+    tree->Branch("event", &event, "event/I");
+    tree->Branch("entry", &entry, "entry/L");
+    for (auto& ev : events) {
+        entry = ev.first;
+        run = Int_t(ev.second >> 32);
+        event = Int_t(ev.second & 0xffffffff);
+        tree->Fill();
+    }
+    tree->Write();
+    TParameter<Long64_t>("HPS_Event_entries", nentries_).Write();
+    TNamed("HPS_Event_uuid", uuid_.c_str()).Write();
+    file->Close();
+    current->cd();
+    return true;
+}
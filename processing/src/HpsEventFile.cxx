@@ -1,4 +1,11 @@
 #include "HpsEventFile.h"
+#include "TTreeCache.h"
+#include "TBranchElement.h"
+#include "TBranchObject.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
 
 HpsEventFile::HpsEventFile(const std::string ifilename, const std::string& ofilename){
   rootfile_ = new TFile(ifilename.c_str());
@@ -15,13 +22,302 @@ void HpsEventFile::setupEvent(IEvent* ievent) {
   //TODO protect the tree pointer
   if (intree_) {
     event_      -> setTree(intree_);
-    maxEntries_ = intree_->GetEntriesFast();
+    ranges_     = EntryRanges{std::make_pair((Long64_t)0, intree_->GetEntriesFast())};
   }
   
+  irange_     = 0;
   entry_      = 0;
 }
 
+void HpsEventFile::activateUsedBranches(const std::vector<std::string>& extra_branches) {
+  if (!intree_)
+    return;
+
+  // The skimmed branches are copied, so they need to be read as well
+  std::vector<std::string> extra(extra_branches);
+  extra.insert(extra.end(), skimBranches_.begin(), skimBranches_.end());
+
+  std::vector<std::string> active;
+  TObjArray* branches = intree_->GetListOfBranches();
+  for (int ib = 0; ib < branches->GetEntriesFast(); ++ib) {
+    TBranch* branch = (TBranch*)branches->At(ib);
+    if (branch->GetAddress() || std::find(extra.begin(), extra.end(), branch->GetName()) != extra.end())
+      active.push_back(branch->GetName());
+  }
+  activeBranches_ = active;
+
+  intree_->SetBranchStatus("*", 0);
+  UInt_t found = 0;
+  for (auto& name : active) {
+    // Enable the branch and, for split objects, all of its sub-branches
+    intree_->SetBranchStatus(name.c_str(), 1, &found);
+    intree_->SetBranchStatus((name + ".*").c_str(), 1, &found);
+  }
+
+  std::cout << "HpsEventFile: reading " << active.size() << "/" 
+            << branches->GetEntriesFast() << " branches" << std::endl;
+}
+
+void HpsEventFile::beginWagon() {
+  addresses_.clear();
+  if (!intree_)
+    return;
+
+  TObjArray* branches = intree_->GetListOfBranches();
+  for (int ib = 0; ib < branches->GetEntriesFast(); ++ib) {
+    TBranch* branch = (TBranch*)branches->At(ib);
+    if (branch->GetAddress())
+      addresses_[branch->GetName()] = branch->GetAddress();
+  }
+}
+
+void HpsEventFile::endWagon() {
+  if (!intree_)
+    return;
+
+  TObjArray* branches = intree_->GetListOfBranches();
+  for (int ib = 0; ib < branches->GetEntriesFast(); ++ib) {
+    TBranch* branch = (TBranch*)branches->At(ib);
+    auto owner = addresses_.find(branch->GetName());
+    if (owner == addresses_.end() || branch->GetAddress() == owner->second)
+      continue;
+
+    // Only object branches are read through a pointer which can be shared
+    if (!branch->InheritsFrom(TBranchElement::Class()) && !branch->InheritsFrom(TBranchObject::Class()))
+      throw std::runtime_error("HpsEventFile: branch " + std::string(branch->GetName()) 
+              + " can't be shared between wagons");
+
+    BranchAlias alias;
+    alias.owner_ = owner->second;
+    alias.alias_ = branch->GetAddress();
+    branch->SetAddress(alias.owner_);
+    *(void**)alias.alias_ = *(void**)alias.owner_;
+    aliases_.push_back(alias);
+  }
+  addresses_.clear();
+}
+
+void HpsEventFile::updateAliases() {
+  for (auto& alias : aliases_)
+    *(void**)alias.alias_ = *(void**)alias.owner_;
+}
+
+void HpsEventFile::setupSkim(const std::vector<std::string>& branches) {
+  if (!intree_)
+    return;
+
+  // Only the active branches are cloned
+  UInt_t found = 0;
+  if (branches.empty()) {
+    intree_->SetBranchStatus("*", 1);
+  } else {
+    intree_->SetBranchStatus("*", 0);
+    for (auto& name : branches) {
+      intree_->SetBranchStatus(name.c_str(), 1, &found);
+      intree_->SetBranchStatus((name + ".*").c_str(), 1, &found);
+    }
+  }
+
+  TDirectory* current = gDirectory;
+  ofile_->cd();
+  skimtree_ = intree_->CloneTree(0);
+  current->cd();
+
+  skimBranches_.clear();
+  TObjArray* skimmed = skimtree_->GetListOfBranches();
+  for (int ib = 0; ib < skimmed->GetEntriesFast(); ++ib)
+    skimBranches_.push_back(skimmed->At(ib)->GetName());
+
+  intree_->SetBranchStatus("*", 1);
+  std::cout << "HpsEventFile: skimming " << skimBranches_.size() << "/" 
+            << intree_->GetListOfBranches()->GetEntriesFast() << " branches" << std::endl;
+}
+
+void HpsEventFile::fillSkim() {
+  if (!skimtree_)
+    return;
+
+  // Lazy branches may not have been read for this event
+  for (auto& name : lazyBranches_) {
+    if (std::find(skimBranches_.begin(), skimBranches_.end(), name) != skimBranches_.end())
+      event_->loadBranch(name);
+  }
+  skimtree_->Fill();
+}
+
+void HpsEventFile::writeSkim() {
+  if (!skimtree_)
+    return;
+
+  TDirectory* current = gDirectory;
+  ofile_->cd();
+  skimtree_->Write();
+  current->cd();
+}
+
+void HpsEventFile::setLazyBranches(const std::vector<std::string>& lazy_branches) {
+  if (!intree_)
+    return;
+
+  for (auto& name : lazy_branches) {
+    if (event_->addLazyBranch(name))
+      lazyBranches_.push_back(name);
+    else
+      std::cout << "HpsEventFile: lazy branch " << name << " not found" << std::endl;
+  }
+}
+
+void HpsEventFile::setupCache(Long64_t cache_size, int learn_entries, 
+        const std::vector<std::string>& cache_branches) {
+  if (!intree_)
+    return;
+
+  if (cache_size >= 0)
+    intree_->SetCacheSize(cache_size);
+  if (cache_size == 0)
+    return;
+  if (!ranges_.empty())
+    intree_->SetCacheEntryRange(ranges_.front().first, ranges_.back().second);
+
+  if (learn_entries > 0) {
+    TTreeCache::SetLearnEntries(learn_entries);
+    return;
+  }
+
+  std::vector<std::string> branches(cache_branches);
+  if (branches.empty()) {
+    if (activeBranches_.empty()) {
+      TObjArray* all = intree_->GetListOfBranches();
+      for (int ib = 0; ib < all->GetEntriesFast(); ++ib)
+        activeBranches_.push_back(all->At(ib)->GetName());
+    }
+    for (auto& name : activeBranches_) {
+      if (std::find(lazyBranches_.begin(), lazyBranches_.end(), name) == lazyBranches_.end())
+        branches.push_back(name);
+    }
+  }
+
+  for (auto& name : branches)
+    intree_->AddBranchToCache(name.c_str(), true);
+  intree_->StopCacheLearningPhase();
+}
+
+void HpsEventFile::printReadStats() {
+  if (!rootfile_)
+    return;
+
+  std::cout << "HpsEventFile: " << rootfile_->GetName() << " read calls: " << rootfile_->GetReadCalls()
+            << " bytes read: " << rootfile_->GetBytesRead();
+  TTreeCache* cache = intree_ ? dynamic_cast<TTreeCache*>(rootfile_->GetCacheRead(intree_)) : nullptr;
+  if (cache) {
+    std::cout << " cache size: " << cache->GetBufferSize() 
+              << " cache efficiency: " << cache->GetEfficiency()
+              << " relative efficiency: " << cache->GetEfficiencyRel();
+  }
+  std::cout << std::endl;
+}
+
+void HpsEventFile::setEntryRange(Long64_t first, Long64_t last) {
+  setEntryRanges(EntryRanges{std::make_pair(first, last)});
+}
+
+void HpsEventFile::setEntryRanges(const EntryRanges& ranges) {
+  if (!intree_)
+    return;
+  
+  Long64_t nentries = intree_->GetEntriesFast();
+  ranges_.clear();
+  for (auto& range : ranges) {
+    Long64_t first = std::max(range.first, (Long64_t)0);
+    Long64_t last = std::min(range.second, nentries);
+    if (first < last)
+      ranges_.push_back(std::make_pair(first, last));
+  }
+  irange_ = 0;
+  entry_  = ranges_.empty() ? 0 : ranges_[0].first;
+}
+
+std::vector<Long64_t> HpsEventFile::getClusterBounds(TTree* tree, Long64_t first, Long64_t last) {
+
+  std::vector<Long64_t> bounds{first};
+  TTree::TClusterIterator clusters = tree->GetClusterIterator(first);
+  Long64_t start = 0;
+  while ((start = clusters()) < last) {
+    if (start > first)
+      bounds.push_back(start);
+  }
+  bounds.push_back(last);
+  return bounds;
+}
+
+HpsEventFile::EntryRanges HpsEventFile::getClusterRanges(TTree* tree, Long64_t first, Long64_t last, int nranges) {
+
+  EntryRanges ranges;
+  if (!tree || first >= last)
+    return ranges;
+
+  // Collect the start of every cluster in the [first, last) window
+  std::vector<Long64_t> bounds = getClusterBounds(tree, first, last);
+
+  // Move each ideal split point to the next cluster boundary
+  nranges = std::max(nranges, 1);
+  Long64_t begin = first;
+  for (int irange = 1; irange <= nranges && begin < last; ++irange) {
+    Long64_t target = first + ((last - first) * irange) / nranges;
+    Long64_t end = *std::lower_bound(bounds.begin(), bounds.end(), target);
+    if (end <= begin)
+      continue;
+    ranges.push_back(std::make_pair(begin, end));
+    begin = end;
+  }
+
+  return ranges;
+}
+
+HpsEventFile::EntryRanges HpsEventFile::getShardRanges(TTree* tree, Long64_t first, Long64_t last, 
+        int shard, int nshards, bool modulo) {
+
+  EntryRanges ranges;
+  if (!tree || first >= last || shard < 0 || shard >= nshards)
+    return ranges;
+
+  if (!modulo) {
+    EntryRanges shards = getClusterRanges(tree, first, last, nshards);
+    if (shard < (int)shards.size())
+      ranges.push_back(shards[shard]);
+    return ranges;
+  }
+
+  // Assign the clusters to the shards in turn, merging adjacent clusters 
+  // when there is a single shard
+  std::vector<Long64_t> bounds = getClusterBounds(tree, first, last);
+  for (unsigned int icluster = shard; icluster + 1 < bounds.size(); icluster += nshards) {
+    if (!ranges.empty() && ranges.back().second == bounds[icluster])
+      ranges.back().second = bounds[icluster + 1];
+    else
+      ranges.push_back(std::make_pair(bounds[icluster], bounds[icluster + 1]));
+  }
+  return ranges;
+}
+
+HpsEventFile::EntryRanges HpsEventFile::truncateRanges(const EntryRanges& ranges, Long64_t max_entries) {
+
+  if (max_entries < 0)
+    return ranges;
+
+  EntryRanges truncated;
+  for (auto& range : ranges) {
+    if (max_entries <= 0)
+      break;
+    Long64_t last = std::min(range.second, range.first + max_entries);
+    truncated.push_back(std::make_pair(range.first, last));
+    max_entries -= last - range.first;
+  }
+  return truncated;
+}
+
 void HpsEventFile::close() {
+  printReadStats();
   rootfile_->cd();
   rootfile_->Close();
   ofile_->cd();
@@ -31,11 +327,19 @@ void HpsEventFile::close() {
 
 bool HpsEventFile::nextEvent() {
   
-  if (entry_ > maxEntries_ - 1)
+  // Move to the next entry range once the current one is done
+  while (irange_ < ranges_.size() && entry_ >= ranges_[irange_].second) {
+    if (++irange_ < ranges_.size())
+      entry_ = ranges_[irange_].first;
+  }
+  if (irange_ >= ranges_.size())
     return false;
 
   //TODO Really don't like having the tree associated to the event object. Should be associated to the EventFile.
+  // Lazy branches are disabled, so they are skipped here and read on request
+  event_->setEntry(entry_);
   intree_->GetEntry(entry_++);
+  updateAliases();
   
   return true;
 } 
@@ -0,0 +1,301 @@
+/**
+ * @file MemoryProfiler.cxx
+ * @brief Class used to attribute the heap allocations and the memory
+ *        growth of a job to the processors.
+ */
+
+#include "MemoryProfiler.h"
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#ifdef HPSTR_MEMORY_PROFILING
+#include <malloc.h>
+#endif
+
+namespace {
+
+    /** Maximum number of stages.  The stages added beyond are counted in the framework. */
+    const int MAX_STAGES{1024};
+
+    /** Stage of the bookkeeping of the profiler, left out of the leak search. */
+    const int PROFILER_STAGE{1};
+
+    /**
+     * @struct Counters
+     * @brief Allocations of a stage.  Constant initialized, so they can be
+     *        used by the allocations made before main.
+     */
+    struct Counters {
+        std::atomic<long> allocs_{0};
+        std::atomic<long> frees_{0};
+        std::atomic<long> allocated_{0};
+        std::atomic<long> freed_{0};
+    };
+
+    Counters counters[MAX_STAGES];
+
+    /** Stage running on the current thread. */
+    thread_local int current_stage{0};
+
+    /** True once the profiling is enabled. */
+    std::atomic<bool> counting{false};
+
+    /**
+     * @struct State
+     * @brief The stages and the samples, only used outside of the
+     *        allocation hooks.
+     */
+    struct State {
+        std::mutex mutex_;
+        long interval_{0};
+        std::vector<std::string> names_{"framework", "profiler"};
+        std::map<std::string, MemoryProfiler::Stages> processors_;
+        std::vector<long> sample_events_;
+        std::vector<std::vector<long> > sample_net_;
+    };
+
+    State& state() {
+        static State state;
+        return state;
+    }
+
+    int addStage(State& s, const std::string& name) {
+        if ((int)s.names_.size() == MAX_STAGES)
+            return 0;
+        s.names_.push_back(name);
+        return s.names_.size() - 1;
+    }
+
+    long net(int stage) {
+        return counters[stage].allocated_.load(std::memory_order_relaxed)
+            - counters[stage].freed_.load(std::memory_order_relaxed);
+    }
+
+    double megabytes(long bytes) {
+        return bytes/(1024.*1024.);
+    }
+}
+
+#ifdef HPSTR_MEMORY_PROFILING
+
+namespace {
+
+    void* allocate(std::size_t size) noexcept {
+        void* ptr = std::malloc(size ? size : 1);
+        if (ptr && counting.load(std::memory_order_relaxed)) {
+            Counters& c = counters[current_stage];
+            c.allocs_.fetch_add(1, std::memory_order_relaxed);
+            c.allocated_.fetch_add(malloc_usable_size(ptr), std::memory_order_relaxed);
+        }
+        return ptr;
+    }
+
+    void deallocate(void* ptr) noexcept {
+        if (!ptr)
+            return;
+        if (counting.load(std::memory_order_relaxed)) {
+            Counters& c = counters[current_stage];
+            c.frees_.fetch_add(1, std::memory_order_relaxed);
+            c.freed_.fetch_add(malloc_usable_size(ptr), std::memory_order_relaxed);
+        }
+        std::free(ptr);
+    }
+}
+
+void* operator new(std::size_t size) {
+    void* ptr = allocate(size);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](std::size_t size) {
+    void* ptr = allocate(size);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void operator delete(void* ptr) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+
+#endif
+
+MemoryProfiler::Scope::Scope(int stage) : previous_(current_stage) {
+    current_stage = stage;
+}
+
+MemoryProfiler::Scope::~Scope() {
+    current_stage = previous_;
+}
+
+void MemoryProfiler::enable(long interval) {
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex_);
+    s.interval_ = interval;
+    counting.store(interval > 0);
+}
+
+bool MemoryProfiler::enabled() {
+    return counting.load(std::memory_order_relaxed);
+}
+
+bool MemoryProfiler::countsAllocations() {
+#ifdef HPSTR_MEMORY_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+MemoryProfiler::Stages MemoryProfiler::addProcessor(const std::string& name) {
+    Scope scope(PROFILER_STAGE);
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex_);
+    auto it = s.processors_.find(name);
+    if (it != s.processors_.end())
+        return it->second;
+    Stages stages;
+    stages.initialize_ = addStage(s, name + "/initialize");
+    stages.process_ = addStage(s, name + "/process");
+    stages.finalize_ = addStage(s, name + "/finalize");
+    s.processors_[name] = stages;
+    return stages;
+}
+
+void MemoryProfiler::sample(long n_events) {
+    if (!enabled())
+        return;
+    Scope scope(PROFILER_STAGE);
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex_);
+    if (s.interval_ <= 0 || n_events%s.interval_ != 0)
+        return;
+
+    std::vector<long> sample(s.names_.size());
+    long heap = 0;
+    for (unsigned int is = 0; is < sample.size(); ++is) {
+        sample[is] = net(is);
+        heap += sample[is];
+    }
+    s.sample_events_.push_back(n_events);
+    s.sample_net_.push_back(sample);
+
+    std::cout << std::fixed << std::setprecision(1)
+        << "---- [ hpstr ][ MemoryProfiler ]: Event: " << n_events
+        << " RSS: " << megabytes(residentBytes()) << " MB"
+        << " peak: " << megabytes(peakResidentBytes()) << " MB";
+    if (countsAllocations())
+        std::cout << " heap: " << megabytes(heap) << " MB";
+    std::cout << std::defaultfloat << std::endl;
+}
+
+void MemoryProfiler::print(std::ostream& out) {
+    if (!enabled())
+        return;
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex_);
+
+    out << "---- [ hpstr ][ MemoryProfiler ]: RSS: " << std::fixed << std::setprecision(1)
+        << megabytes(residentBytes()) << " MB peak: " << megabytes(peakResidentBytes()) << " MB" << std::endl;
+    if (!countsAllocations()) {
+        out << "---- [ hpstr ][ MemoryProfiler ]: Configure with -DMEMORY_PROFILING=ON to attribute "
+            << "the allocations to the processors" << std::endl;
+        out << std::defaultfloat;
+        return;
+    }
+
+    out << std::left << std::setw(48) << "Stage" << std::right
+        << std::setw(14) << "Allocations" << std::setw(14) << "Frees"
+        << std::setw(16) << "Allocated [MB]" << std::setw(14) << "Freed [MB]"
+        << std::setw(12) << "Net [MB]" << std::endl;
+    for (unsigned int is = 0; is < s.names_.size(); ++is) {
+        long allocs = counters[is].allocs_.load(std::memory_order_relaxed);
+        long frees = counters[is].frees_.load(std::memory_order_relaxed);
+        if (allocs == 0 && frees == 0)
+            continue;
+        out << std::left << std::setw(48) << s.names_[is] << std::right
+            << std::setw(14) << allocs << std::setw(14) << frees
+            << std::setw(16) << megabytes(counters[is].allocated_.load(std::memory_order_relaxed))
+            << std::setw(14) << megabytes(counters[is].freed_.load(std::memory_order_relaxed))
+            << std::setw(12) << megabytes(net(is)) << std::endl;
+    }
+
+    // A stage is suspect if its net bytes grew over most of the sampled
+    // windows.  The first sample is the baseline, so the allocations made
+    // while warming up aren't counted.
+    unsigned int n_samples = s.sample_net_.size();
+    if (n_samples < 3) {
+        out << "---- [ hpstr ][ MemoryProfiler ]: Not enough samples to look for leaks" << std::endl;
+        out << std::defaultfloat;
+        return;
+    }
+    const std::vector<long>& first = s.sample_net_.front();
+    const std::vector<long>& last = s.sample_net_.back();
+    long n_events = s.sample_events_.back() - s.sample_events_.front();
+    bool suspects = false;
+    for (unsigned int is = 0; is < first.size(); ++is) {
+        long growth = last[is] - first[is];
+        if (is == PROFILER_STAGE || growth <= 0)
+            continue;
+        unsigned int n_growing = 0;
+        for (unsigned int isample = 1; isample < n_samples; ++isample) {
+            if (s.sample_net_[isample][is] > s.sample_net_[isample - 1][is])
+                ++n_growing;
+        }
+        if (4*n_growing < 3*(n_samples - 1))
+            continue;
+        if (!suspects)
+            out << "---- [ hpstr ][ MemoryProfiler ]: Leak suspects:" << std::endl;
+        suspects = true;
+        out << "    " << s.names_[is] << ": grew by " << megabytes(growth) << " MB in "
+            << n_events << " events (" << std::setprecision(0) << (double)growth/n_events
+            << " bytes/event), growing in " << n_growing << "/" << n_samples - 1 << " samples"
+            << std::setprecision(1) << std::endl;
+    }
+    if (!suspects)
+        out << "---- [ hpstr ][ MemoryProfiler ]: No leak suspects" << std::endl;
+    out << std::defaultfloat;
+}
+
+long MemoryProfiler::residentBytes() {
+    long size = 0, resident = 0;
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (!statm)
+        return 0;
+    if (fscanf(statm, "%ld %ld", &size, &resident) != 2)
+        resident = 0;
+    fclose(statm);
+    return resident*sysconf(_SC_PAGESIZE);
+}
+
+long MemoryProfiler::peakResidentBytes() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss;
+#else
+    return usage.ru_maxrss*1024;
+#endif
+}
@@ -0,0 +1,108 @@
+/**
+ * @file OutputMerger.cxx
+ * @brief Class used to merge the ROOT output files of hpstr jobs.
+ */
+
+#include "OutputMerger.h"
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+//----------//
+//   ROOT   //
+//----------//
+#include "TFileMerger.h"
+#include "TROOT.h"
+#include "TSystem.h"
+
+OutputMerger::OutputMerger(int threads, int fanin) : 
+    threads_(std::max(threads, 1)), fanin_(std::max(fanin, 2)) {}
+
+void OutputMerger::merge(const std::vector<std::string>& inputs, const std::string& output) {
+
+    if (inputs.empty())
+        throw std::runtime_error("[ OutputMerger ]: No input files to merge.");
+
+    if (threads_ > 1)
+        ROOT::EnableThreadSafety();
+
+    std::vector<std::string> current(inputs);
+    for (int level = 0; ; ++level) {
+
+        // Split the files of this level in groups, keeping their order
+        std::vector<std::vector<std::string> > groups;
+        for (unsigned int ifile = 0; ifile < current.size(); ifile += fanin_) 
+            groups.push_back(std::vector<std::string>(current.begin() + ifile, 
+                        current.begin() + std::min(ifile + fanin_, (unsigned int)current.size())));
+
+        std::vector<std::string> outputs;
+        if (groups.size() == 1) 
+            outputs.push_back(output);
+        else {
+            for (unsigned int igroup = 0; igroup < groups.size(); ++igroup) 
+                outputs.push_back(output + ".merge" + std::to_string(level) + "_" + std::to_string(igroup) + ".root");
+        }
+
+        std::cout << "---- [ hpstr-merge ]: Level " << level << ": merging " << current.size() 
+            << " files into " << outputs.size() << std::endl;
+
+        // Merge the groups on the worker threads
+        std::vector<std::string> errors(groups.size());
+        std::atomic<unsigned int> next{0};
+        auto worker = [&]() {
+            for (unsigned int igroup = next++; igroup < groups.size(); igroup = next++) 
+                errors[igroup] = mergeGroup(groups[igroup], outputs[igroup]);
+        };
+        int nthreads = std::min((int)groups.size(), threads_);
+        std::vector<std::thread> workers;
+        for (int ithread = 1; ithread < nthreads; ++ithread)
+            workers.emplace_back(worker);
+        worker();
+        for (auto& thread : workers)
+            thread.join();
+
+        // Intermediate files are removed once they have been merged
+        if (level > 0) {
+            for (auto& file : current)
+                gSystem->Unlink(file.c_str());
+        }
+
+        for (unsigned int igroup = 0; igroup < groups.size(); ++igroup) {
+            if (!errors[igroup].empty()) {
+                for (auto& file : outputs)
+                    if (file != output) gSystem->Unlink(file.c_str());
+                throw std::runtime_error("[ OutputMerger ]: " + errors[igroup]);
+            }
+        }
+
+        if (groups.size() == 1)
+            break;
+        current = outputs;
+    }
+}
+
+std::string OutputMerger::mergeGroup(const std::vector<std::string>& inputs, const std::string& output) const {
+
+    TFileMerger merger(false, false);
+    merger.SetPrintLevel(0);
+    merger.SetMaxOpenedFiles(fanin_ + 1);
+    if (!merger.OutputFile(output.c_str(), "RECREATE"))
+        return "Unable to open output file " + output;
+
+    for (auto& input : inputs) {
+        if (!merger.AddFile(input.c_str(), false))
+            return "Unable to open input file " + input;
+    }
+
+    // Merge the objects of each input into the output in turn
+    if (!merger.PartialMerge(TFileMerger::kAll | TFileMerger::kIncremental))
+        return "Failed merging into " + output;
+
+    return "";
+}
@@ -9,7 +9,33 @@
 #include "Process.h"
 #include "EventFile.h"
 #include "HpsEventFile.h"
+#include "ProcessorFactory.h"
+#include "ProcessTimer.h"
+#include "EventIndex.h"
+#include "TaskPool.h"
 #include "TH1.h"
+#include "TROOT.h"
+#include "TFileMerger.h"
+#include "TSystem.h"
+#include "TEnv.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+#include <fnmatch.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 Process::Process() {}
 
@@ -17,19 +43,28 @@ Process::Process() {}
 
 void Process::runOnHisto() {
     try {
+        ProcessTimer timer;
+        for (auto module : sequence_)
+            timer.addStage(module->getName());
         int cfile = 0;
         for (auto ifile : input_files_) {
             std::cout << "Processing file " << ifile << std::endl;
 
-            for (auto module : sequence_) {
+            for (unsigned int im = 0; im < sequence_.size(); ++im) {
+                Processor* module = sequence_[im];
                 module->initialize(ifile, output_files_[cfile]);
-                module->process();
+                ProcessTimer::Clock::time_point start = ProcessTimer::Clock::now();
+                bool pass = module->process();
+                timer.record(im, start, pass);
                 module->finalize();
             }
             //Pass to next file
             ++cfile;
 
         } //ifile
+        // The processors manage their own output files in this mode
+        if (timing_)
+            timer.print(std::cout);
     } catch (std::exception& e) {
         std::cerr<<"Error:"<<e.what()<<std::endl;
     }
@@ -37,7 +72,23 @@ void Process::runOnHisto() {
 
 void Process::runOnRoot() {
     try {
-        int n_events_processed = 0;
+        long n_events_processed = 0;
+        // Needs to be set before the input files are opened
+        if (async_prefetch_)
+            gEnv->SetValue("TFile.AsyncPrefetching", 1);
+        if (threads_ > 1 && !wagons_.empty()) {
+            std::cout<<"Running the "<<wagons_.size()<<" wagons on a single thread"<<std::endl;
+        } else if (threads_ > 1) {
+            // Each worker owns its processors, event and files
+            ROOT::EnableThreadSafety();
+            int cfile = 0;
+            for (auto ifile : input_files_) {
+                std::cout<<"Processing file "<<ifile<<" with "<<threads_<<" threads"<<std::endl;
+                runOnRootThreaded(ifile, output_files_[cfile], n_events_processed);
+                ++cfile;
+            }
+            return;
+        }
         HpsEvent event;
         TH1D * event_h = new TH1D("event_h","Number of Events Processed;;Events", 21, -10.5, 10.5);
         int cfile =0 ;
@@ -47,22 +98,72 @@ void Process::runOnRoot() {
             if (!output_files_.empty()) {
                 file = new HpsEventFile(ifile, output_files_[cfile]);
                 file->setupEvent(&event);
+                file->setEntryRanges(getEntryRanges(event.getTree(), ifile));
+            }
+            std::vector<MemoryProfiler::Stages> memory = makeMemoryStages(sequence_);
+            for (unsigned int im = 0; im < sequence_.size(); ++im) {
+                MemoryProfiler::Scope scope(memory[im].initialize_);
+                sequence_[im]->initialize(event.getTree());
+                sequence_[im]->setFile(file->getOutputFile());
             }
-            for (auto module : sequence_) {
-                module->initialize(event.getTree());
-                module->setFile(file->getOutputFile());
+            // The wagons share the input tree, each of them writing to its own file
+            std::vector<TFile*> wagon_files;
+            std::vector<std::vector<MemoryProfiler::Stages> > wagon_memory;
+            for (auto& wagon : wagons_) {
+                if (cfile >= (int)wagon.output_files_.size())
+                    throw std::runtime_error("No output file for wagon " + wagon.name_ + " and input " + ifile);
+                wagon_files.push_back(new TFile(wagon.output_files_[cfile].c_str(), "RECREATE"));
+                file->beginWagon();
+                wagon_memory.push_back(makeMemoryStages(wagon.sequence_));
+                for (unsigned int im = 0; im < wagon.sequence_.size(); ++im) {
+                    MemoryProfiler::Scope scope(wagon_memory.back()[im].initialize_);
+                    wagon.sequence_[im]->initialize(event.getTree());
+                    wagon.sequence_[im]->setFile(wagon_files.back());
+                }
+                file->endWagon();
+            }
+            file->resetOutputFileDir();
+            if (skim_)
+                file->setupSkim(skim_branches_);
+            if (active_branches_only_)
+                file->activateUsedBranches(extra_branches_);
+            file->setLazyBranches(lazy_branches_);
+            file->setupCache(event_list_.empty() ? cache_size_ : 0, cache_learn_entries_, cache_branches_);
+            ProcessTimer timer = makeTimer(sequence_, false);
+            for (auto& wagon : wagons_) {
+                for (auto module : wagon.sequence_)
+                    timer.addStage(wagon.name_ + "/" + module->getName());
             }
+            ProcessTimer::Clock::time_point start = ProcessTimer::Clock::now();
             while (file->nextEvent() && (event_limit_ < 0 || (n_events_processed < event_limit_))) {
+                start = timer.record(0, start);
                 if (n_events_processed%1000 == 0)
                     std::cout<<"Event:"<<n_events_processed<<std::endl;
 
                 //In this way if the processing fails (like an event doesn't pass the selection, the other modules aren't run on that event)
-                for (auto module : sequence_) {
-                    module->process(&event);
+                bool passEvent = true;
+                for (unsigned int im = 0; im < sequence_.size(); ++im) {
+                    MemoryProfiler::Scope scope(memory[im].process_);
+                    bool pass = sequence_[im]->process(&event);
+                    passEvent = passEvent && pass;
+                    start = timer.record(im + 1, start, pass);
+                }
+                // The selection of each wagon is independent of the others
+                int stage = sequence_.size() + 1;
+                for (unsigned int iw = 0; iw < wagons_.size(); ++iw) {
+                    for (unsigned int im = 0; im < wagons_[iw].sequence_.size(); ++im) {
+                        MemoryProfiler::Scope scope(wagon_memory[iw][im].process_);
+                        bool pass = wagons_[iw].sequence_[im]->process(&event);
+                        start = timer.record(stage++, start, pass);
+                    }
                 }
+                if (skim_ && passEvent)
+                    file->fillSkim();
                 //event.Clear();
                 event_h->Fill(0.0);
                 ++n_events_processed;
+                MemoryProfiler::sample(n_events_processed);
+                start = ProcessTimer::Clock::now();
             }
             //Pass to next file
             ++cfile;
@@ -71,9 +172,30 @@ void Process::runOnRoot() {
             //Select the output file for storing the results of the processors.
             file->resetOutputFileDir();
             event_h->Write();
-            for (auto module : sequence_) {
+            file->writeSkim();
+            if (timing_) {
+                timer.print(std::cout);
+                timer.write(file->getOutputFile());
+            }
+            for (unsigned int im = 0; im < sequence_.size(); ++im) {
                 //TODO:Change the finalize method
-                module->finalize();
+                MemoryProfiler::Scope scope(memory[im].finalize_);
+                sequence_[im]->finalize();
+            }
+            for (unsigned int iw = 0; iw < wagons_.size(); ++iw) {
+                TFile* wagon_file = wagon_files[iw];
+                wagon_file->cd();
+                wagon_file->WriteTObject(event_h);
+                if (timing_)
+                    timer.write(wagon_file);
+                for (unsigned int im = 0; im < wagons_[iw].sequence_.size(); ++im) {
+                    MemoryProfiler::Scope scope(wagon_memory[iw][im].finalize_);
+                    wagons_[iw].sequence_[im]->finalize();
+                }
+                // Some processors close their output file themselves
+                if (wagon_file->IsOpen())
+                    wagon_file->Close();
+                delete wagon_file;
             }
             // TODO Check all these destructors
             if (file) {
@@ -83,92 +205,577 @@ void Process::runOnRoot() {
                 delete event_h;
                 event_h = nullptr;
             }
+            MemoryProfiler::print(std::cout);
         }
     } catch (std::exception& e) {
         std::cerr<<"Error:"<<e.what()<<std::endl;
     }
 }
 
-void Process::run() {
+void Process::runOnRootThreaded(const std::string& ifile, const std::string& ofile, long& n_events_processed) {
+
+    // Split the selected entries of the input tree in cluster aligned 
+    // entry ranges, one list for each worker
+    std::vector<HpsEventFile::EntryRanges> ranges;
+    {
+        TFile infile(ifile.c_str());
+        TTree* intree = (TTree*)infile.Get("HPS_Event");
+        if (!intree)
+            throw std::runtime_error("HPS_Event tree not found in " + ifile);
+        HpsEventFile::EntryRanges selected = getEntryRanges(intree, ifile);
+        if (event_limit_ >= 0)
+            selected = HpsEventFile::truncateRanges(selected, std::max(event_limit_ - n_events_processed, 0L));
+        if (selected.size() == 1) {
+            for (auto& range : HpsEventFile::getClusterRanges(intree, selected[0].first, selected[0].second, threads_))
+                ranges.push_back(HpsEventFile::EntryRanges{range});
+        } else if (!selected.empty()) {
+            // Keep the ranges in order so that the merged output follows the input
+            int nworkers = std::min((int)selected.size(), threads_);
+            for (int iw = 0; iw < nworkers; ++iw) 
+                ranges.push_back(HpsEventFile::EntryRanges(selected.begin() + (selected.size()*iw)/nworkers, 
+                            selected.begin() + (selected.size()*(iw + 1))/nworkers));
+        }
+        infile.Close();
+    }
+    if (ranges.empty()) {
+        std::cout<<"No entries to process in "<<ifile<<std::endl;
+        return;
+    }
+
+    // Build one copy of the processor sequence for each worker. The 
+    // processors are created and configured on the main thread.
+    int nworkers = ranges.size();
+    std::vector<std::vector<Processor*> > sequences;
+    std::vector<std::string> worker_files;
+    for (int iw = 0; iw < nworkers; ++iw) {
+        sequences.push_back(makeSequence());
+        worker_files.push_back(ofile + ".thread" + std::to_string(iw) + ".root");
+    }
+
+    std::atomic<long> n_events{0};
+    std::vector<std::string> errors(nworkers);
+    std::vector<ProcessTimer> timers;
+    for (int iw = 0; iw < nworkers; ++iw)
+        timers.push_back(makeTimer(sequences[iw], false));
+    // The copies of a processor share its memory profiler stages
+    std::vector<MemoryProfiler::Stages> memory = makeMemoryStages(sequences[0]);
+
+    auto worker = [&](int iw) {
+        try {
+            HpsEvent event;
+            HpsEventFile file(ifile, worker_files[iw]);
+            file.setupEvent(&event);
+            file.setEntryRanges(ranges[iw]);
+            TH1D* event_h = new TH1D("event_h","Number of Events Processed;;Events", 21, -10.5, 10.5);
+
+            for (unsigned int im = 0; im < sequences[iw].size(); ++im) {
+                MemoryProfiler::Scope scope(memory[im].initialize_);
+                sequences[iw][im]->initialize(event.getTree());
+                sequences[iw][im]->setFile(file.getOutputFile());
+            }
+            if (skim_)
+                file.setupSkim(skim_branches_);
+            if (active_branches_only_)
+                file.activateUsedBranches(extra_branches_);
+            file.setLazyBranches(lazy_branches_);
+            file.setupCache(event_list_.empty() ? cache_size_ : 0, cache_learn_entries_, cache_branches_);
+            ProcessTimer& timer = timers[iw];
+            ProcessTimer::Clock::time_point start = ProcessTimer::Clock::now();
+            while (file.nextEvent()) {
+                start = timer.record(0, start);
+                long ievent = n_events++;
+                if (ievent%1000 == 0) {
+                    std::ostringstream msg;
+                    msg<<"Event:"<<ievent<<"\n";
+                    std::cout<<msg.str()<<std::flush;
+                }
+                bool passEvent = true;
+                for (unsigned int im = 0; im < sequences[iw].size(); ++im) {
+                    MemoryProfiler::Scope scope(memory[im].process_);
+                    bool pass = sequences[iw][im]->process(&event);
+                    passEvent = passEvent && pass;
+                    start = timer.record(im + 1, start, pass);
+                }
+                if (skim_ && passEvent)
+                    file.fillSkim();
+                event_h->Fill(0.0);
+                MemoryProfiler::sample(ievent + 1);
+                start = ProcessTimer::Clock::now();
+            }
+
+            file.resetOutputFileDir();
+            event_h->Write();
+            file.writeSkim();
+            for (unsigned int im = 0; im < sequences[iw].size(); ++im) {
+                MemoryProfiler::Scope scope(memory[im].finalize_);
+                sequences[iw][im]->finalize();
+            }
+            file.close();
+            delete event_h;
+        } catch (std::exception& e) {
+            errors[iw] = e.what();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int iw = 0; iw < nworkers; ++iw)
+        workers.emplace_back(worker, iw);
+    for (auto& thread : workers)
+        thread.join();
+
+    n_events_processed += n_events;
+
+    for (auto& sequence : sequences) {
+        for (auto module : sequence)
+            delete module;
+    }
+
+    for (int iw = 0; iw < nworkers; ++iw) {
+        if (!errors[iw].empty())
+            throw std::runtime_error("Worker " + std::to_string(iw) + " failed: " + errors[iw]);
+    }
 
+    // Merge the worker outputs following the order of the entry ranges so
+    // that histograms and trees are the same from run to run.
+    TFileMerger merger(false, false);
+    merger.SetPrintLevel(0);
+    if (!merger.OutputFile(ofile.c_str(), "RECREATE"))
+        throw std::runtime_error("Unable to open output file " + ofile);
+    for (auto& wfile : worker_files)
+        merger.AddFile(wfile.c_str(), false);
+    if (!merger.Merge())
+        throw std::runtime_error("Failed merging the worker outputs into " + ofile);
+    for (auto& wfile : worker_files)
+        gSystem->Unlink(wfile.c_str());
+
+    if (timing_) {
+        for (int iw = 1; iw < nworkers; ++iw)
+            timers[0].merge(timers[iw]);
+        timers[0].print(std::cout);
+        TFile out(ofile.c_str(), "UPDATE");
+        timers[0].write(&out);
+        out.Close();
+    }
+    MemoryProfiler::print(std::cout);
+}
+
+HpsEventFile::EntryRanges Process::getEntryRanges(TTree* tree, const std::string& ifile) {
+    if (!event_list_.empty()) {
+        // Read only the listed events present in this file
+        EventIndex index = EventIndex::load(ifile);
+        std::vector<Long64_t> entries;
+        for (auto& event : event_list_) {
+            Long64_t entry = index.find(event.first, event.second);
+            if (entry >= 0)
+                entries.push_back(entry);
+        }
+        std::sort(entries.begin(), entries.end());
+        entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+        std::cout << "---- [ hpstr ][ Process ]: Found " << entries.size() << "/" << event_list_.size() 
+            << " listed events in " << ifile << std::endl;
+
+        HpsEventFile::EntryRanges ranges;
+        for (auto entry : entries) {
+            if (!ranges.empty() && ranges.back().second == entry)
+                ++ranges.back().second;
+            else
+                ranges.push_back(std::make_pair(entry, entry + 1));
+        }
+        return ranges;
+    }
+
+    Long64_t nentries = tree->GetEntries();
+    Long64_t last = (last_event_ < 0) ? nentries : std::min((Long64_t)last_event_, nentries);
+    return HpsEventFile::getShardRanges(tree, first_event_, last, shard_index_, n_shards_, shard_modulo_);
+}
+
+void Process::selectEvents(EventFile* file) {
+    if (n_shards_ <= 1) {
+        file->setEventRange(first_event_, last_event_);
+    } else if (shard_modulo_) {
+        file->setEventRange(first_event_ + shard_index_, last_event_, n_shards_);
+    } else {
+        // LCIO files have no clusters, the shards are split on events
+        Long64_t last = file->getNumberOfEvents();
+        if (last_event_ >= 0)
+            last = std::min(last, (Long64_t)last_event_);
+        Long64_t nevents = std::max(last - first_event_, (Long64_t)0);
+        Long64_t first = first_event_ + (nevents*shard_index_)/n_shards_;
+        file->setEventRange(first, first_event_ + (nevents*(shard_index_ + 1))/n_shards_);
+    }
+}
+
+void Process::runOnEventList() {
     try {
+        if (event_list_file_.empty())
+            throw std::runtime_error("Please specify an event list.");
 
-        int n_events_processed = 0;
-        TH1D * event_h = new TH1D("event_h","Number of Events Processed;;Events", 21, -10.5, 10.5);
+        std::ifstream list(event_list_file_);
+        if (!list.is_open())
+            throw std::runtime_error("Unable to open event list " + event_list_file_);
+        event_list_.clear();
+        int run = 0, event = 0;
+        while (list >> run >> event)
+            event_list_.push_back(std::make_pair(run, event));
+        std::cout << "---- [ hpstr ][ Process ]: Read " << event_list_.size() << " events from " 
+            << event_list_file_ << std::endl;
+    } catch (std::exception& e) {
+        std::cerr<<"Error:"<<e.what()<<std::endl;
+        return;
+    }
+
+    if (!event_list_.empty())
+        runOnRoot();
+}
+
+std::vector<MemoryProfiler::Stages> Process::makeMemoryStages(const std::vector<Processor*>& sequence) {
+    std::vector<MemoryProfiler::Stages> stages;
+    for (auto module : sequence)
+        stages.push_back(MemoryProfiler::addProcessor(module->getName()));
+    return stages;
+}
+
+ProcessTimer Process::makeTimer(const std::vector<Processor*>& sequence, bool fill) {
+    ProcessTimer timer;
+    timer.addStage("read");
+    for (auto module : sequence)
+        timer.addStage(module->getName());
+    if (fill)
+        timer.addStage("fill");
+    return timer;
+}
+
+void Process::run() {
+
+    try {
 
         if (input_files_.empty()) 
             throw std::runtime_error("Please specify files to process.");
 
-        // Create an object used to manage the input and output files.
-        Event event;  
+        if (output_files_.size() < input_files_.size())
+            throw std::runtime_error("Please specify an output file for each input file.");
+
+        if (workers_ > 1 && input_files_.size() > 1) {
+            runWorkers();
+            return;
+        }
 
+        long n_events_processed = 0;
         int cfile = 0; 
         for (auto ifile : input_files_) { 
+            processLcioFile(ifile, output_files_[cfile], n_events_processed);
+            ++cfile; 
+        }
 
-            std::cout << "---- [ hpstr ][ Process ]: Processing file " 
-                << ifile << std::endl;
+    } catch (std::exception& e) {
+        std::cerr << "---- [ hpstr ][ Process ]: Error! " << e.what() << std::endl;
+    }
+}
 
+void Process::processLcioFile(const std::string& ifile, const std::string& ofile, long& n_events_processed) {
 
-            //TODO:: Change the order here.
+    std::cout << "---- [ hpstr ][ Process ]: Processing file " 
+        << ifile << std::endl;
 
-            // Open the output file if an output file path has been specified.
-            EventFile* file{nullptr};  
-            if (!output_files_.empty()) { 
-                file = new EventFile(ifile, output_files_[cfile]);
-                file->setupEvent(&event);  
-            }
+    // Create an object used to manage the input and output files.
+    Event event;  
 
-            TTree* tree = new TTree("HPS_Event","HPS event tree");
-            event.setTree(tree); 
-            // first, notify everyone that we are starting
-            for (auto module : sequence_) {
-                module->initialize(tree);
-            }
+    //TODO:: Change the order here.
 
-            //In the case of additional output files from the processors this restores the correct ProcessID storage
-            file->resetOutputFileDir();
+    // Open the output file
+    EventFile* file = new EventFile(ifile, ofile);
+    file->setupEvent(&event);  
+    file->setReadAhead(read_ahead_);
+    file->setBuildIndex(build_index_);
+    selectEvents(file);
 
-            // Process all events.
-            while (file->nextEvent() && (event_limit_ < 0 || (n_events_processed < event_limit_))) {
-                if (n_events_processed%1000 == 0)
-                    std::cout << "---- [ hpstr ][ Process ]: Event: " << n_events_processed << std::endl;
-                event.Clear(); 
-                bool passEvent = true;
-                
-                for (auto module : sequence_) {
-                    passEvent = passEvent && module->process(&event);
-                    //if (!module->process(&event))
-                    if (!passEvent)
-                        break;
+    TH1D * event_h = new TH1D("event_h","Number of Events Processed;;Events", 21, -10.5, 10.5);
+
+    TTree* tree = new TTree("HPS_Event","HPS event tree");
+    if (write_threads_ > 0) {
+        // Baskets are compressed in parallel when the tree is flushed.  The 
+        // auto-flush size bounds the memory held by the uncompressed baskets.
+        if (!ROOT::IsImplicitMTEnabled())
+            ROOT::EnableImplicitMT(write_threads_);
+        tree->SetImplicitMT(true);
+        tree->SetAutoFlush(-write_buffer_);
+    }
+    if (auto_flush_ != 0)
+        tree->SetAutoFlush(auto_flush_);
+    event.setTree(tree); 
+    for (auto& profile : branch_profiles_) {
+        if (profile.split_level_ >= 0)
+            event.setSplitLevel(profile.branches_, profile.split_level_);
+    }
+    // first, notify everyone that we are starting
+    std::vector<MemoryProfiler::Stages> memory = makeMemoryStages(sequence_);
+    for (unsigned int im = 0; im < sequence_.size(); ++im) {
+        MemoryProfiler::Scope scope(memory[im].initialize_);
+        sequence_[im]->initialize(tree);
+    }
+
+    //In the case of additional output files from the processors this restores the correct ProcessID storage
+    file->resetOutputFileDir();
+    if (columnar_) file->setupColumnar(columnar_collections_);
+    file->applyBranchProfiles(branch_profiles_);
+
+    // Group the independent processors when running them concurrently
+    std::vector<std::vector<int> > waves;
+    std::unique_ptr<TaskPool> pool;
+    if (concurrent_processors_ > 1) {
+        waves = makeWaves(sequence_);
+        ROOT::EnableThreadSafety();
+        pool.reset(new TaskPool(concurrent_processors_));
+        std::cout << "---- [ hpstr ][ Process ]: Running the processors in " 
+            << waves.size() << " waves on " << concurrent_processors_ << " threads" << std::endl;
+        for (unsigned int iwave = 0; iwave < waves.size(); ++iwave) {
+            std::cout << "---- [ hpstr ][ Process ]:   wave " << iwave << ":";
+            for (int im : waves[iwave]) 
+                std::cout << " " << sequence_[im]->getName();
+            std::cout << std::endl;
+        }
+    }
+
+    // Process all events.
+    ProcessTimer timer = makeTimer(sequence_, true);
+    int fill_stage = sequence_.size() + 1;
+    std::vector<char> results(sequence_.size(), true);
+    ProcessTimer::Clock::time_point start = ProcessTimer::Clock::now();
+    while (file->nextEvent() && (event_limit_ < 0 || (n_events_processed < event_limit_))) {
+        start = timer.record(0, start);
+        if (progress_fd_ < 0 && n_events_processed%1000 == 0)
+            std::cout << "---- [ hpstr ][ Process ]: Event: " << n_events_processed << std::endl;
+        event.Clear(); 
+        bool passEvent = true;
+
+        if (pool) {
+            // The processors of a wave don't share any output, and their 
+            // inputs are complete once the previous waves are done.  The 
+            // remaining waves are skipped once a processor rejects the event,
+            // and so are the tasks of the wave not started yet which follow
+            // the rejecting processor in the sequence.
+            std::atomic<int> rejected{(int)sequence_.size()};
+            for (auto& wave : waves) {
+                std::vector<std::function<void()> > tasks;
+                for (int im : wave) {
+                    tasks.push_back([this, im, &event, &timer, &results, &memory, &rejected]() {
+                        if (rejected.load() < im) {
+                            results[im] = false;
+                            return;
+                        }
+                        MemoryProfiler::Scope scope(memory[im].process_);
+                        ProcessTimer::Clock::time_point task_start = ProcessTimer::Clock::now();
+                        results[im] = sequence_[im]->process(&event);
+                        timer.record(im + 1, task_start, results[im]);
+                        int first = rejected.load();
+                        while (!results[im] && im < first && !rejected.compare_exchange_weak(first, im)) {}
+                    });
                 }
-                ++n_events_processed;
-                event_h->Fill(0.0);
-                if (passEvent) {
-                    file->FillEvent();
+                pool->run(tasks);
+                for (int im : wave) 
+                    passEvent = passEvent && results[im];
+                if (!passEvent)
+                    break;
+            }
+            start = ProcessTimer::Clock::now();
+        } else {
+            for (unsigned int im = 0; im < sequence_.size(); ++im) {
+                {
+                    MemoryProfiler::Scope scope(memory[im].process_);
+                    passEvent = passEvent && sequence_[im]->process(&event);
                 }
+                start = timer.record(im + 1, start, passEvent);
+                //if (!module->process(&event))
+                if (!passEvent)
+                    break;
             }
-            ++cfile; 
+        }
+        ++n_events_processed;
+        event_h->Fill(0.0);
+        if (passEvent) {
+            start = ProcessTimer::Clock::now();
+            file->FillEvent();
+            timer.record(fill_stage, start);
+        }
+        if (progress_fd_ >= 0 && n_events_processed%1000 == 0)
+            reportProgress(n_events_processed);
+        MemoryProfiler::sample(n_events_processed);
+        start = ProcessTimer::Clock::now();
+    }
 
-            //Prepare to write to file
-            file->resetOutputFileDir();
-            event_h->Write();
-            // Finalize all modules. 
-            for (auto module : sequence_) { 
-                module->finalize(); 
+    //Prepare to write to file
+    file->resetOutputFileDir();
+    event_h->Write();
+    if (timing_) {
+        timer.print(std::cout);
+        timer.write(gDirectory);
+    }
+    // Finalize all modules. 
+    for (unsigned int im = 0; im < sequence_.size(); ++im) { 
+        MemoryProfiler::Scope scope(memory[im].finalize_);
+        sequence_[im]->finalize(); 
+    }
+
+    file->close(); 
+    delete file;
+    delete event_h;
+    MemoryProfiler::print(std::cout);
+
+    if (progress_fd_ >= 0)
+        reportProgress(n_events_processed);
+}
+
+void Process::reportProgress(long n_events) {
+    // Messages are smaller than PIPE_BUF, so they are written atomically
+    if (write(progress_fd_, &n_events, sizeof(n_events)) < 0)
+        progress_fd_ = -1;
+}
+
+void Process::runWorkers() {
+
+    if (output_files_.size() != input_files_.size())
+        throw std::runtime_error("One output file per input file is needed to run with multiple workers.");
+
+    /** Bookkeeping of a running worker process. */
+    struct Worker {
+        int   ifile;
+        int   fd;
+        long  n_events;
+    };
+
+    std::map<pid_t, Worker> running;
+    std::vector<long> file_events(input_files_.size(), 0);
+    std::vector<std::string> failures;
+    unsigned int next_file = 0;
+    unsigned int n_done = 0;
+    time_t last_report = time(nullptr);
+
+    std::cout << "---- [ hpstr ][ Process ]: Converting " << input_files_.size() 
+        << " files with " << workers_ << " workers" << std::endl;
+
+    // Stop the running workers and remove their partial outputs before giving up
+    auto abortWorkers = [&](const std::string& msg) {
+        for (auto& worker : running) {
+            kill(worker.first, SIGTERM);
+            close(worker.second.fd);
+            waitpid(worker.first, nullptr, 0);
+            std::remove(output_files_[worker.second.ifile].c_str());
+        }
+        running.clear();
+        throw std::runtime_error(msg);
+    };
+
+    while (next_file < input_files_.size() || !running.empty()) {
+
+        // Keep the pool full
+        while (running.size() < (unsigned int)workers_ && next_file < input_files_.size()) {
+            int fds[2];
+            if (pipe(fds) < 0)
+                abortWorkers("Unable to create pipe for worker process.");
+
+            // Make sure buffered output isn't duplicated in the child
+            std::cout.flush();
+            std::cerr.flush();
+
+            pid_t pid = fork();
+            if (pid < 0) {
+                close(fds[0]);
+                close(fds[1]);
+                abortWorkers("Unable to fork worker process.");
             }
 
-            if (file) {
-                file->close(); 
-                delete file;
-                file = nullptr;
-                delete event_h;
-                event_h = nullptr;
+            if (pid == 0) {
+                // Worker: convert a single file and report through the pipe
+                close(fds[0]);
+                for (auto& other : running)
+                    close(other.second.fd);
+                progress_fd_ = fds[1];
+                int status = 0;
+                try {
+                    long n_events_processed = 0;
+                    processLcioFile(input_files_[next_file], output_files_[next_file], n_events_processed);
+                } catch (std::exception& e) {
+                    std::cerr << "---- [ hpstr ][ Process ]: Error processing " 
+                        << input_files_[next_file] << ": " << e.what() << std::endl;
+                    status = 1;
+                }
+                close(fds[1]);
+                std::cout.flush();
+                std::cerr.flush();
+                _exit(status);
             }
 
+            close(fds[1]);
+            running[pid] = {(int)next_file, fds[0], 0};
+            ++next_file;
         }
 
-    } catch (std::exception& e) {
-        std::cerr << "---- [ hpstr ][ Process ]: Error! " << e.what() << std::endl;
+        // Wait for progress messages or for workers to finish
+        std::vector<struct pollfd> pfds;
+        std::vector<pid_t> pids;
+        for (auto& worker : running) {
+            pfds.push_back({worker.second.fd, POLLIN, 0});
+            pids.push_back(worker.first);
+        }
+        if (poll(pfds.data(), pfds.size(), 1000) < 0 && errno != EINTR)
+            abortWorkers("Failed polling the worker processes.");
+
+        for (unsigned int iw = 0; iw < pfds.size(); ++iw) {
+            if (!(pfds[iw].revents & (POLLIN | POLLHUP | POLLERR)))
+                continue;
+
+            Worker& worker = running[pids[iw]];
+            long msgs[64];
+            ssize_t nbytes = read(worker.fd, msgs, sizeof(msgs));
+            if (nbytes >= (ssize_t)sizeof(long)) {
+                worker.n_events = msgs[nbytes/sizeof(long) - 1];
+                file_events[worker.ifile] = worker.n_events;
+                continue;
+            }
+            if (nbytes < 0 && errno == EINTR)
+                continue;
+
+            // End of file on the pipe: the worker is done
+            close(worker.fd);
+            int status = 0;
+            waitpid(pids[iw], &status, 0);
+            ++n_done;
+            const std::string& ifile = input_files_[worker.ifile];
+            if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+                std::cout << "---- [ hpstr ][ Process ]: Done " << ifile << " -> " 
+                    << output_files_[worker.ifile] << " (" << worker.n_events << " events)" << std::endl;
+            } else {
+                if (WIFSIGNALED(status))
+                    failures.push_back(ifile + " (signal " + std::to_string(WTERMSIG(status)) + ")");
+                else
+                    failures.push_back(ifile + " (exit code " + std::to_string(WEXITSTATUS(status)) + ")");
+                std::cerr << "---- [ hpstr ][ Process ]: Failed " << failures.back() << std::endl;
+            }
+            running.erase(pids[iw]);
+        }
+
+        time_t now = time(nullptr);
+        if (now - last_report >= 10) {
+            long n_events = 0;
+            for (auto n : file_events)
+                n_events += n;
+            std::cout << "---- [ hpstr ][ Process ]: Files done " << n_done << "/" << input_files_.size() 
+                << ", running " << running.size() << ", events converted " << n_events << std::endl;
+            last_report = now;
+        }
+    }
+
+    long n_events = 0;
+    for (auto n : file_events)
+        n_events += n;
+    std::cout << "---- [ hpstr ][ Process ]: Converted " << n_events << " events from " 
+        << input_files_.size() - failures.size() << "/" << input_files_.size() << " files" << std::endl;
+
+    if (!failures.empty()) {
+        std::string msg = std::to_string(failures.size()) + " file(s) failed:";
+        for (auto& failure : failures)
+            msg += " " + failure;
+        throw std::runtime_error(msg);
     }
 }
 
@@ -180,7 +787,67 @@ void Process::addOutputFileName(const std::string& output_filename) {
     output_files_.push_back(output_filename);
 }
 
+int Process::getSplitLevel(const std::string& name, int splitlevel) const {
+    for (auto& profile : branch_profiles_) {
+        if (profile.split_level_ >= 0 && fnmatch(profile.branches_.c_str(), name.c_str(), 0) == 0)
+            splitlevel = profile.split_level_;
+    }
+    return splitlevel;
+}
+
 void Process::addToSequence(Processor* mod) {
     sequence_.push_back(mod);
 }
 
+void Process::addProcessorConfig(const std::string& classname, const std::string& instancename, 
+        const ParameterSet& params) {
+    configs_.push_back({classname, instancename, params});
+}
+
+void Process::addWagon(const std::string& name, const std::vector<Processor*>& sequence, 
+        const std::vector<std::string>& output_files) {
+    wagons_.push_back(Wagon{name, sequence, output_files});
+}
+
+std::vector<std::vector<int> > Process::makeWaves(const std::vector<Processor*>& sequence) {
+
+    auto overlaps = [](const std::vector<std::string>& a, const std::vector<std::string>& b) {
+        for (auto& name : a) {
+            if (std::find(b.begin(), b.end(), name) != b.end()) return true;
+        }
+        return false;
+    };
+
+    std::vector<std::vector<int> > waves;
+    std::vector<int> levels(sequence.size(), 0);
+    for (unsigned int im = 0; im < sequence.size(); ++im) {
+        Processor* module = sequence[im];
+        for (unsigned int jm = 0; jm < im; ++jm) {
+            Processor* previous = sequence[jm];
+            bool conflict = !module->hasDependencies() || !previous->hasDependencies()
+                || overlaps(module->getConsumes(), previous->getProduces())
+                || overlaps(module->getProduces(), previous->getProduces())
+                || overlaps(module->getProduces(), previous->getConsumes());
+            if (conflict) 
+                levels[im] = std::max(levels[im], levels[jm] + 1);
+        }
+        if (levels[im] >= (int)waves.size()) 
+            waves.resize(levels[im] + 1);
+        waves[levels[im]].push_back(im);
+    }
+    return waves;
+}
+
+std::vector<Processor*> Process::makeSequence() {
+    std::vector<Processor*> sequence;
+    for (auto& config : configs_) {
+        Processor* proc = ProcessorFactory::instance().createProcessor(config.classname_, config.instancename_, *this);
+        if (proc == 0) {
+            throw std::runtime_error("[ Process ]: Unable to create instance of " + config.instancename_);
+        }
+        proc->configure(config.params_);
+        sequence.push_back(proc);
+    }
+    return sequence;
+}
+
@@ -0,0 +1,146 @@
+/**
+ * @file ProcessTimer.cxx
+ * @brief Class used to accumulate the time spent in each stage of the 
+ *        event processing.
+ */
+
+#include "ProcessTimer.h"
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+//----------//
+//   ROOT   //
+//----------//
+#include "TH1.h"
+#include "TNamed.h"
+
+constexpr int ProcessTimer::BUCKETS_PER_DECADE;
+constexpr double ProcessTimer::MIN_LATENCY;
+constexpr int ProcessTimer::N_BUCKETS;
+
+int ProcessTimer::addStage(const std::string& name) {
+    Stage stage;
+    stage.name_ = name;
+    stage.buckets_.resize(N_BUCKETS, 0);
+    stages_.push_back(stage);
+    return stages_.size() - 1;
+}
+
+ProcessTimer::Clock::time_point ProcessTimer::record(int istage, const Clock::time_point& start, bool pass) {
+    Clock::time_point now = Clock::now();
+    double elapsed = std::chrono::duration<double>(now - start).count();
+
+    Stage& stage = stages_[istage];
+    ++stage.calls_;
+    if (pass) ++stage.passed_;
+    stage.total_ += elapsed;
+    stage.max_ = std::max(stage.max_, elapsed);
+
+    int bucket = 0;
+    if (elapsed > MIN_LATENCY) 
+        bucket = std::min(int(std::log10(elapsed/MIN_LATENCY)*BUCKETS_PER_DECADE), N_BUCKETS - 1);
+    ++stage.buckets_[bucket];
+
+    return now;
+}
+
+void ProcessTimer::merge(const ProcessTimer& other) {
+    if (other.stages_.size() != stages_.size())
+        throw std::runtime_error("[ ProcessTimer ]: Can't merge timers with different stages.");
+
+    for (unsigned int istage = 0; istage < stages_.size(); ++istage) {
+        Stage& stage = stages_[istage];
+        const Stage& ostage = other.stages_[istage];
+        stage.calls_ += ostage.calls_;
+        stage.passed_ += ostage.passed_;
+        stage.total_ += ostage.total_;
+        stage.max_ = std::max(stage.max_, ostage.max_);
+        for (int ib = 0; ib < N_BUCKETS; ++ib)
+            stage.buckets_[ib] += ostage.buckets_[ib];
+    }
+}
+
+double ProcessTimer::percentile(const Stage& stage, double fraction) const {
+    if (stage.calls_ == 0) return 0;
+
+    // Use the upper edge of the bucket containing the percentile
+    long target = std::max(long(std::ceil(fraction*stage.calls_)), 1L);
+    long count = 0;
+    for (int ib = 0; ib < N_BUCKETS; ++ib) {
+        count += stage.buckets_[ib];
+        if (count >= target)
+            return std::min(MIN_LATENCY*std::pow(10., double(ib + 1)/BUCKETS_PER_DECADE), stage.max_);
+    }
+    return stage.max_;
+}
+
+void ProcessTimer::print(std::ostream& out) const {
+    double total = 0;
+    for (auto& stage : stages_) 
+        total += stage.total_;
+
+    out << "---- [ hpstr ][ ProcessTimer ]: Timing report" << std::endl;
+    out << std::left << std::setw(28) << "Stage" << std::right 
+        << std::setw(12) << "Calls" << std::setw(10) << "Pass [%]" 
+        << std::setw(12) << "Total [s]" << std::setw(8) << "[%]" 
+        << std::setw(12) << "Mean [ms]" << std::setw(12) << "p50 [ms]" 
+        << std::setw(12) << "p99 [ms]" << std::setw(12) << "Max [ms]" << std::endl;
+
+    out << std::fixed;
+    for (auto& stage : stages_) {
+        out << std::left << std::setw(28) << stage.name_ << std::right 
+            << std::setw(12) << stage.calls_ 
+            << std::setw(10) << std::setprecision(1) << (stage.calls_ ? 100.*stage.passed_/stage.calls_ : 0.)
+            << std::setw(12) << std::setprecision(3) << stage.total_ 
+            << std::setw(8) << std::setprecision(1) << (total > 0 ? 100.*stage.total_/total : 0.)
+            << std::setw(12) << std::setprecision(4) << (stage.calls_ ? 1e3*stage.total_/stage.calls_ : 0.)
+            << std::setw(12) << 1e3*percentile(stage, 0.5) 
+            << std::setw(12) << 1e3*percentile(stage, 0.99) 
+            << std::setw(12) << 1e3*stage.max_ << std::endl;
+    }
+    out << std::defaultfloat;
+}
+
+std::string ProcessTimer::toJson() const {
+    std::ostringstream json;
+    json << "{\"stages\": [";
+    for (unsigned int istage = 0; istage < stages_.size(); ++istage) {
+        const Stage& stage = stages_[istage];
+        if (istage > 0) json << ", ";
+        json << "{\"name\": \"" << stage.name_ << "\""
+             << ", \"calls\": " << stage.calls_ 
+             << ", \"passed\": " << stage.passed_
+             << ", \"total_s\": " << stage.total_
+             << ", \"mean_s\": " << (stage.calls_ ? stage.total_/stage.calls_ : 0.)
+             << ", \"p50_s\": " << percentile(stage, 0.5)
+             << ", \"p99_s\": " << percentile(stage, 0.99)
+             << ", \"max_s\": " << stage.max_ << "}";
+    }
+    json << "]}";
+    return json.str();
+}
+
+void ProcessTimer::write(TDirectory* dir) const {
+    TDirectory* current = gDirectory;
+    dir->cd();
+
+    TH1D timing_h("processing_time_h", "Processing time per stage;;Time [s]", 
+            stages_.size(), 0, stages_.size());
+    for (unsigned int istage = 0; istage < stages_.size(); ++istage) {
+        timing_h.GetXaxis()->SetBinLabel(istage + 1, stages_[istage].name_.c_str());
+        timing_h.SetBinContent(istage + 1, stages_[istage].total_);
+    }
+    timing_h.Write();
+
+    TNamed summary("processing_time_json", toJson().c_str());
+    summary.Write();
+
+    current->cd();
+}
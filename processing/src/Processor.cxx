@@ -6,6 +6,7 @@
 
 #include "Processor.h" 
 #include "ProcessorFactory.h"
+#include "Process.h"
 
 Processor::Processor(const std::string& name, Process& process) :
     process_ (process ), name_ { name } {
@@ -14,3 +15,7 @@ Processor::Processor(const std::string& name, Process& process) :
 void Processor::declare(const std::string& classname, ProcessorMaker* maker) {
     ProcessorFactory::instance().registerProcessor(classname, maker);
 }
+
+int Processor::getSplitLevel(const std::string& name, int splitlevel) const {
+    return process_.getSplitLevel(name, splitlevel);
+}
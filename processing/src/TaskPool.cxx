@@ -0,0 +1,67 @@
+/**
+ * @file TaskPool.cxx
+ * @brief Pool of threads used to run groups of tasks concurrently.
+ */
+
+#include "TaskPool.h"
+
+TaskPool::TaskPool(int nthreads) {
+    for (int ithread = 1; ithread < nthreads; ++ithread) 
+        threads_.emplace_back(&TaskPool::work, this);
+}
+
+TaskPool::~TaskPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    work_cv_.notify_all();
+    for (auto& thread : threads_)
+        thread.join();
+}
+
+void TaskPool::run(const std::vector<std::function<void()> >& tasks) {
+    if (tasks.empty()) 
+        return;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    tasks_ = &tasks;
+    next_ = 0;
+    pending_ = tasks.size();
+    error_ = nullptr;
+    work_cv_.notify_all();
+
+    while (next_ < tasks_->size())
+        runNext(lock);
+    done_cv_.wait(lock, [this] { return pending_ == 0; });
+    tasks_ = nullptr;
+
+    if (error_) 
+        std::rethrow_exception(error_);
+}
+
+void TaskPool::work() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        work_cv_.wait(lock, [this] { return stop_ || (tasks_ && next_ < tasks_->size()); });
+        if (stop_) 
+            return;
+        runNext(lock);
+    }
+}
+
+void TaskPool::runNext(std::unique_lock<std::mutex>& lock) {
+    const std::function<void()>& task = (*tasks_)[next_++];
+    lock.unlock();
+    std::exception_ptr error;
+    try {
+        task();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    lock.lock();
+    if (error && !error_) 
+        error_ = error;
+    if (--pending_ == 0) 
+        done_cv_.notify_all();
+}
@@ -82,6 +82,11 @@ int main(int argc, char **argv) {
             std::cout<<"---- [ hpstr ]: Running Histo Analysis Process --------" << std::endl;
             p->runOnHisto();
         }
+        else if (run_mode == 3)
+        {
+            std::cout<<"---- [ hpstr ]: Running ROOT -> Histo Process on Event List --------" << std::endl;
+            p->runOnEventList();
+        }
         else 
         {
             std::cout<<"---- [ hpstr ]: Run Mode " << run_mode << " does not exist! --------" << std::endl;
@@ -0,0 +1,52 @@
+import HpstrConf
+import os
+import sys
+
+# Use the input file to set the output file names
+inFilename  = sys.argv[1].strip()
+outFilename = '%s_anaTrks.root' % inFilename[:-5]
+hitFilename = '%s_anaTrkHits.root' % inFilename[:-5]
+
+print('Input file:  %s' % inFilename)
+print('Output files: %s %s' % (outFilename, hitFilename))
+
+p = HpstrConf.Process()
+
+p.run_mode = 1
+#p.max_events = 1000
+
+# Library containing processors
+p.add_library("libprocessors")
+
+###############################
+#          Processors         #
+###############################
+anaTrks = HpstrConf.Processor('anaTrks', 'TrackingAnaProcessor')
+anaTrkHits = HpstrConf.Processor('anaTrkHits', 'TrackHitAnaProcessor')
+
+###############################
+#   Processor Configuration   #
+###############################
+anaTrks.parameters["debug"] = 0
+anaTrks.parameters["histCfg"] = os.environ['HPSTR_BASE']+'/analysis/plotconfigs/tracking/basicTracking.json'
+anaTrks.parameters["trkCollName"] = 'GBLTracks'
+
+anaTrkHits.parameters["debug"] = 0
+anaTrkHits.parameters["trkCollName"] = 'GBLTracks'
+anaTrkHits.parameters["histCfg"] = os.environ['HPSTR_BASE']+'/analysis/plotconfigs/tracking/trackHit.json'
+anaTrkHits.parameters["selectionjson"] = os.environ['HPSTR_BASE']+'/analysis/selections/trackHit/trackHitAna.json'
+
+# Sequence which the processors will run.
+p.sequence = [anaTrks]
+
+# The wagons read the same events as the main sequence, in a single pass
+# over the input file, and write their own output files.
+trkHits = HpstrConf.Wagon('trkHits')
+trkHits.sequence = [anaTrkHits]
+trkHits.output_files = [hitFilename]
+p.wagons = [trkHits]
+
+p.input_files=[inFilename]
+p.output_files = [outFilename]
+
+p.printProcess()
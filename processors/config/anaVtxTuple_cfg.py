@@ -41,6 +41,9 @@ vtxana.parameters["trkColl"] = "KalmanFullTracks"
 vtxana.parameters["hitColl"] = "SiClustersOnTrack"
 vtxana.parameters["vtxColl"] = "UnconstrainedV0Vertices_KF"
 vtxana.parameters["mcColl"]  = "MCParticle"
+#Collections the track hits and vertex particles are indexed in
+vtxana.parameters["trkHitColl"] = "SiClustersOnTrack"
+vtxana.parameters["partColl"] = "ParticlesOnVertices_KF"
 vtxana.parameters["analysis"]  = "vertex"
 vtxana.parameters["vtxSelectionjson"] = os.environ['HPSTR_BASE']+'/analysis/selections/vertexSelection_2019.json'
 vtxana.parameters["mcHistoCfg"] = os.environ['HPSTR_BASE']+'/analysis/plotconfigs/mc/basicMC.json'
@@ -32,6 +32,7 @@
 #include "CalCluster.h"
 #include "CalHit.h"
 #include "Collections.h"
+#include "ObjectPool.h"
 #include "Processor.h"
 
 typedef long long long64;
@@ -92,11 +93,13 @@ class ECalDataProcessor : public Processor {
 
         /** TClonesArray collection containing all ECal hits. */ 
         std::vector<CalHit*> cal_hits_; 
+        ObjectPool<CalHit> cal_hit_pool_;
         std::string hitCollLcio_{"EcalCalHits"};
         std::string hitCollRoot_{"RecoEcalHits"};
 
         /** TClonesArray collection containing all ECal clusters. */
         std::vector<CalCluster*> clusters_; 
+        ObjectPool<CalCluster> cluster_pool_;
         std::string clusCollLcio_{"EcalClustersCorr"};
         std::string clusCollRoot_{"RecoEcalClusters"};
 
@@ -12,6 +12,8 @@
 //-----------------//
 //   C++  StdLib   //
 //-----------------//
+#include <map>
+#include <set>
 #include <string>
 #include <iostream>
 #include <fstream>
@@ -105,7 +107,7 @@ class EventProcessor : public Processor {
 
         //single events checks
         std::string run_evt_list_{""};
-        std::map<int,std::vector<int > > run_evts_map_;
+        std::map<int,std::set<int > > run_evts_map_;
         
         //Debug Level
         int debug_{0};
@@ -13,6 +13,7 @@
 #include "Processor.h"
 #include "HodoHit.h"
 #include "HodoCluster.h"
+#include "ObjectPool.h"
 
 //----------//
 //   LCIO   //
@@ -83,9 +84,11 @@ public:
   
   /** vector containing all ECal hits. */
   std::vector<HodoHit*> hits_;
+  ObjectPool<HodoHit> hit_pool_;
   
   /** vector containing all ECal clusters. */
   std::vector<HodoCluster*> clusters_;
+  ObjectPool<HodoCluster> cluster_pool_;
   
   /** Encoding string describing cell ID. */
   const std::string encoder_string_{"system:6,barrel:3,layer:4,ix:4,iy:-3,hole:-3"};
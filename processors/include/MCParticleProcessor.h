@@ -36,6 +36,7 @@
 #include "CalCluster.h"
 #include "Collections.h"
 #include "MCParticle.h"
+#include "ObjectPool.h"
 #include "Processor.h"
 #include "Track.h"
 #include "Event.h"
@@ -84,6 +85,7 @@ class MCParticleProcessor : public Processor {
 
         /** Map to hold all particle collections. */
         std::vector<MCParticle*> mc_particles_{}; 
+        ObjectPool<MCParticle> mc_particle_pool_;
         std::string mcPartCollLcio_{"MCParticle"};
         std::string mcPartCollRoot_{"MCParticle"};
 
@@ -34,6 +34,7 @@
 #include "Processor.h"
 #include "RawSvtHit.h"
 #include "Event.h"
+#include "ObjectPool.h"
 
 class TTree; 
 
@@ -81,6 +82,7 @@ class SvtRawDataProcessor : public Processor {
 
         /** Container to hold all TrackerHit objects, and collection names. */
         std::vector<RawSvtHit*> rawhits_; 
+        ObjectPool<RawSvtHit> rawhit_pool_;
         std::string hitCollLcio_{"SVTRawTrackerHits"};
         std::string hitfitCollLcio_{"SVTFittedRawTrackerHits"};
         std::string hitCollRoot_{"SVTRawTrackerHits"};
@@ -81,6 +81,11 @@ class TrackHitAnaProcessor : public Processor {
         // Track Collection name
         std::string trkCollName_;
 
+        /** Hit collection the track hit indices refer to.  Optional. */
+        std::vector<TrackerHit*> * hits_{nullptr};
+        TBranch*           bhits_{nullptr};
+        std::string hitCollName_{""};
+
         // Track Selector configuration
         std::string selectionCfg_;
         std::shared_ptr<BaseSelector> trkSelector_;
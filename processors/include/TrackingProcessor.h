@@ -37,6 +37,7 @@
 #include "Track.h"
 #include "TrackerHit.h"
 #include "Event.h"
+#include "ObjectPool.h"
 #include "RawSvtHit.h"
 #include "TrackHistos.h"
 
@@ -107,6 +108,12 @@ class TrackingProcessor : public Processor {
         std::vector<Track*> truthTracks_{};
         std::string truthTracksCollRoot_{""};
         std::string truthTracksCollLcio_{""};
+
+        /** Pools of the objects built for each event. */
+        ObjectPool<TrackerHit> hit_pool_;
+        ObjectPool<Track> track_pool_;
+        ObjectPool<RawSvtHit> rawhit_pool_;
+        ObjectPool<Track> truth_track_pool_;
         
         //Debug Level
         int debug_{false};
@@ -122,6 +129,13 @@ class TrackingProcessor : public Processor {
         //Bfield
         double bfield_{-1.};
 
+        /** 
+         * Store the hit links as TRefs in addition to the indices.  Readers 
+         * of the hits through the reference arrays, e.g. for collections 
+         * which aren't written, need them.
+         */
+        int storeRefs_{1};
+
 
 
 
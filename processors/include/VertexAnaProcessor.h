@@ -64,6 +64,8 @@ class VertexAnaProcessor : public Processor {
         TBranch* bts_{nullptr};
         TBranch* bvtxs_{nullptr};
         TBranch* bhits_{nullptr};
+        TBranch* btrkHits_{nullptr};
+        TBranch* bparts_{nullptr};
         TBranch* btrks_{nullptr};
         TBranch* bmcParts_{nullptr};
         TBranch* bevth_{nullptr};
@@ -75,6 +77,8 @@ class VertexAnaProcessor : public Processor {
         std::vector<Vertex*> * vtxs_{};
         std::vector<Track*>  * trks_{};
         std::vector<TrackerHit*>  * hits_{};
+        std::vector<TrackerHit*>  * trkHits_{};
+        std::vector<Particle*>    * parts_{};
         std::vector<MCParticle*>  * mcParts_{};
 
         std::string anaName_{"vtxAna"};
@@ -82,6 +86,10 @@ class VertexAnaProcessor : public Processor {
         std::string vtxColl_{"Vertices"};
         std::string hitColl_{"RotatedHelicalTrackHits"};
         std::string trkColl_{"GBLTracks"};
+        //Collections the track hit and vertex particle indices refer to. The TRefs are
+        //followed instead if they are empty or missing from the input
+        std::string trkHitColl_{"SiClustersOnTrack"};
+        std::string partColl_{"ParticlesOnVertices_KF"};
         std::string ecalColl_{"RecoEcalClusters"};
         std::string mcColl_{"MCParticle"};
         TTree* tree_{nullptr};
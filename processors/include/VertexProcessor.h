@@ -23,6 +23,7 @@
 //-----------//
 //   hpstr   //
 //-----------//
+#include "ObjectPool.h"
 #include "Processor.h"
 #include "Vertex.h"
 #include "Particle.h"
@@ -76,6 +77,12 @@ class VertexProcessor : public Processor {
         /** Containers to hold all TrackerHit objects. */
         std::vector<Vertex*>   vtxs_{}; 
         std::vector<Particle*> parts_{}; 
+
+        /** Pools of the objects built for each event. */
+        ObjectPool<Vertex> vtx_pool_;
+        ObjectPool<Particle> part_pool_;
+        ObjectPool<Track> track_pool_;
+        ObjectPool<CalCluster> cluster_pool_;
         std::string vtxCollLcio_{"UnconstrainedV0Vertices"};
         std::string vtxCollRoot_{"UnconstrainedV0Vertices"};
         std::string partCollRoot_{"ParticlesOnVertices"};
@@ -85,6 +92,9 @@ class VertexProcessor : public Processor {
         //Debug Level
         int debug_{0};
 
+        /** Store the particle links as TRefs in addition to the indices. */
+        int storeRefs_{1};
+
 }; // VertexProcessor
 
 #endif // __VERTEX_PROCESSOR_H__
@@ -31,6 +31,7 @@
 #include "CalCluster.h"
 #include "CalHit.h"
 #include "Event.h"
+#include "ObjectPool.h"
 #include "TrackerHit.h"
 
 namespace utils {
@@ -38,30 +39,42 @@ namespace utils {
 
     bool hasCollection(EVENT::LCEvent* lc_event,const std::string& collection);
 
-    Vertex* buildVertex(EVENT::Vertex* lc_vertex);
+    /*
+     * The build methods take the object to fill from the given pool, if 
+     * any, and create a new object otherwise.
+     */
+
+    Vertex* buildVertex(EVENT::Vertex* lc_vertex, ObjectPool<Vertex>* pool = nullptr);
     
     Particle* buildParticle(EVENT::ReconstructedParticle* lc_particle, 
                             EVENT::LCCollection* gbl_kink_data,
-                            EVENT::LCCollection* track_data);
+                            EVENT::LCCollection* track_data,
+                            ObjectPool<Particle>* pool = nullptr,
+                            ObjectPool<Track>* track_pool = nullptr,
+                            ObjectPool<CalCluster>* cluster_pool = nullptr);
 
     Track* buildTrack(EVENT::Track* lc_track, 
             EVENT::LCCollection* gbl_kink_data, 
-            EVENT::LCCollection* track_data);
+            EVENT::LCCollection* track_data,
+            ObjectPool<Track>* pool = nullptr);
 
 
     bool IsSameTrack(Track* trk1, Track* trk2);
 
     RawSvtHit* buildRawHit(EVENT::TrackerRawData* rawTracker_hit,
-            EVENT::LCCollection* raw_svt_hit_fits);
+            EVENT::LCCollection* raw_svt_hit_fits,
+            ObjectPool<RawSvtHit>* pool = nullptr);
 
-    TrackerHit* buildTrackerHit(IMPL::TrackerHitImpl* lc_trackerHit,bool rotate=true, int type = 0);
+    TrackerHit* buildTrackerHit(IMPL::TrackerHitImpl* lc_trackerHit,bool rotate=true, int type = 0,
+            ObjectPool<TrackerHit>* pool = nullptr);
 
-    CalCluster* buildCalCluster(EVENT::Cluster* lc_cluster);
+    CalCluster* buildCalCluster(EVENT::Cluster* lc_cluster, ObjectPool<CalCluster>* pool = nullptr);
 
     bool addRawInfoTo3dHit(TrackerHit* tracker_hit,
                            IMPL::TrackerHitImpl* lc_tracker_hit,
                            EVENT::LCCollection* raw_svt_fits,
-                           std::vector<RawSvtHit*>* rawHits = nullptr, int type = 0);
+                           std::vector<RawSvtHit*>* rawHits = nullptr, int type = 0,
+                           ObjectPool<RawSvtHit>* pool = nullptr, bool ref = true);
 
 
     bool isUsedByTrack(IMPL::TrackerHitImpl* lc_tracker_hit,
@@ -70,7 +83,8 @@ namespace utils {
     bool isUsedByTrack(TrackerHit* tracker_hit,
             EVENT::Track* lc_track);
 
-    bool getParticlesFromVertex(Vertex* vtx, Particle* ele, Particle* pos);
+    bool getParticlesFromVertex(Vertex* vtx, Particle* ele, Particle* pos, 
+            const std::vector<Particle*>* parts = nullptr);
     
     //TODO: extern?
     static UTIL::BitField64 decoder("system:6,barrel:3,layer:4,module:12,sensor:1,side:32:-2,strip:12");
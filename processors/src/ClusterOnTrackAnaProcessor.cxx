@@ -54,8 +54,10 @@ bool ClusterOnTrackAnaProcessor::process(IEvent* ievent) {
             return false;
         }
 
-        for (int ihit = 0; ihit<track->getSvtHits()->GetEntries(); ++ihit) {
-            TrackerHit* hit3d = (TrackerHit*) track->getSvtHits()->At(ihit);
+        for (int ihit = 0; ihit<track->getNHitLinks(); ++ihit) {
+            TrackerHit* hit3d = track->getHit(ihit);
+            if (!hit3d)
+                continue;
             clusterHistos->FillHistograms(hit3d, 1.);
         }
     }
@@ -29,21 +29,26 @@ void ECalDataProcessor::configure(const ParameterSet& parameters) {
     {
         std::cout << error.what() << std::endl;
     }
+
+    declareConsumes(hitCollLcio_);
+    declareConsumes(clusCollLcio_);
+    if (!hitCollRoot_.empty()) declareProduces(hitCollRoot_);
+    declareProduces(clusCollRoot_);
 }
 
 void ECalDataProcessor::initialize(TTree* tree) {
     if (!hitCollRoot_.empty())
-        tree->Branch(hitCollRoot_.c_str(), &cal_hits_);
-    tree->Branch(clusCollRoot_.c_str(), &clusters_);
+        addBranch(tree, hitCollRoot_, &cal_hits_);
+    addBranch(tree, clusCollRoot_, &clusters_);
 }
 
 bool ECalDataProcessor::process(IEvent* ievent) {
 
     if(debug_ > 0) std::cout << "[ECalDataProcessor] Running Process" << std::endl;
-    for(int i = 0; i < cal_hits_.size(); i++) delete cal_hits_.at(i);
     cal_hits_.clear();
-    for(int i = 0; i < clusters_.size(); i++) delete clusters_.at(i);
+    cal_hit_pool_.reset();
     clusters_.clear();
+    cluster_pool_.reset();
     // Attempt to retrieve the collection "TimeCorrEcalHits" from the event. If
     // the collection doesn't exist, handle the DataNotAvailableCollection and
     // attempt to retrieve the collection "EcalCalHits". If that collection 
@@ -78,7 +83,7 @@ bool ECalDataProcessor::process(IEvent* ievent) {
         // 0.1 ns resolution is sufficient to distinguish any 2 hits on the same crystal.
         int id1 = static_cast<int>(10.0*lc_hit->getTime()); 
 
-        CalHit* cal_hit = new CalHit();
+        CalHit* cal_hit = cal_hit_pool_.acquire();
 
         // Store the hit in the map for easy access later.
         hit_map[ std::make_pair(id0,id1) ] = cal_hit;
@@ -116,7 +121,7 @@ bool ECalDataProcessor::process(IEvent* ievent) {
         IMPL::ClusterImpl* lc_cluster = static_cast<IMPL::ClusterImpl*>(clusters->getElementAt(icluster));
 
         // Add a cluster to the event
-        CalCluster* cluster = new CalCluster();
+        CalCluster* cluster = cluster_pool_.acquire();
 
         // Set the cluster position
         cluster->setPosition(lc_cluster->getPosition());
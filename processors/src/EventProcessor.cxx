@@ -42,9 +42,9 @@ void EventProcessor::initialize(TTree* tree) {
     header_ = new EventHeader();
     vtpData = new VTPData();
     tsData = new TSData();
-    tree->Branch(headCollRoot_.c_str(), &header_);
-    tree->Branch(vtpCollRoot_.c_str(), &vtpData);
-    tree->Branch(tsCollRoot_.c_str(),  &tsData);
+    addBranch(tree, headCollRoot_, &header_);
+    addBranch(tree, vtpCollRoot_, &vtpData);
+    addBranch(tree, tsCollRoot_, &tsData);
     
     //Cache everything in a map
     if (!run_evt_list_.empty()) {
@@ -55,7 +55,7 @@ void EventProcessor::initialize(TTree* tree) {
             while(!runEvt_ifile.eof()) {
                 runEvt_ifile >> runN >> evtN;
                 //std::cout<<"Adding " <<runN<<" "<<evtN<<std::endl;
-                run_evts_map_[runN].push_back(evtN);
+                run_evts_map_[runN].insert(evtN);
             }// fill the map
             runEvt_ifile.close();
         } // file is open
@@ -76,9 +76,9 @@ bool EventProcessor::process(IEvent* ievent) {
     }
     
     if (!run_evt_list_.empty()) {
-        if (run_evts_map_.find(runNumber)!=run_evts_map_.end()) {
-            auto it = std::find(run_evts_map_[runNumber].begin(), run_evts_map_[runNumber].end(), evtNumber);
-            if ( it != run_evts_map_[runNumber].end())
+        auto itr = run_evts_map_.find(runNumber);
+        if (itr != run_evts_map_.end()) {
+            if (itr->second.count(evtNumber))
                 std::cout<<"Save: "<<runNumber<<" "<<evtNumber<<std::endl;
             else 
                 return false;
@@ -33,7 +33,7 @@ void FinalStateParticleProcessor::configure(const ParameterSet& parameters) {
 
 void FinalStateParticleProcessor::initialize(TTree* tree) {
     // Add branches to tree
-    tree->Branch(fspCollRoot_.c_str(),  &fsps_);
+    addBranch(tree, fspCollRoot_, &fsps_);
 }
 
 bool FinalStateParticleProcessor::process(IEvent* ievent) {
@@ -7,8 +7,8 @@
 #include "HodoDataProcessor.h"
 
 void HodoDataProcessor::initialize(TTree* tree) {
-  tree->Branch(hitCollRoot_.c_str(), &hits_);
-  tree->Branch(clusCollRoot_.c_str(), &clusters_);
+  addBranch(tree, hitCollRoot_, &hits_);
+  addBranch(tree, clusCollRoot_, &clusters_);
 }
 
 
@@ -26,16 +26,21 @@ void HodoDataProcessor::configure(const ParameterSet& parameters) {
   {
     std::cout << error.what() << std::endl;
   }
+
+  declareConsumes(hitCollLcio_);
+  declareConsumes(clusCollLcio_);
+  declareProduces(hitCollRoot_);
+  declareProduces(clusCollRoot_);
 }
 
 
 bool HodoDataProcessor::process(IEvent* ievent) {
   
-  // Clean up. TODO:: new/delete is an inefficient way to go about all this. Fix with better memory use.
-  for(int i = 0; i < hits_.size(); i++) delete hits_.at(i);
-  for(int i = 0; i < clusters_.size(); i++) delete clusters_.at(i);
+  // Clean up. The hits and clusters of the previous event are reused.
   hits_.clear();
+  hit_pool_.reset();
   clusters_.clear();
+  cluster_pool_.reset();
   
   // Interface to implementation cast. Not sure why we bother with an interface.
   Event* event = static_cast<Event*> (ievent);
@@ -56,16 +61,13 @@ bool HodoDataProcessor::process(IEvent* ievent) {
     // Grab the hit from the collection and push it as a HodoHit object onto the vector<HodoHit *> hits_
     IMPL::CalorimeterHitImpl *hit=static_cast<IMPL::CalorimeterHitImpl *>(lcio_hits->getElementAt(i));
 
-    // TODO: This is inefficient, doing a new and delete on every hit for every event ==> implement proper memory use.
-    hits_.push_back(new HodoHit(
-                                getIdentifierFieldValue("ix", hit),
-                                getIdentifierFieldValue("iy", hit),
-                                getIdentifierFieldValue("layer", hit),
-                                getIdentifierFieldValue("hole", hit),
-                                hit->getEnergy(),
-                                hit->getTime()
-                                )
-                    );
+    HodoHit* hodo_hit = hit_pool_.acquire();
+    hodo_hit->setIndices(getIdentifierFieldValue("ix", hit), getIdentifierFieldValue("iy", hit));
+    hodo_hit->setLayer(getIdentifierFieldValue("layer", hit));
+    hodo_hit->setHole(getIdentifierFieldValue("hole", hit));
+    hodo_hit->setEnergy(hit->getEnergy());
+    hodo_hit->setTime(hit->getTime());
+    hits_.push_back(hodo_hit);
   }
   
   // Now deal with the clusters.
@@ -85,12 +87,12 @@ bool HodoDataProcessor::process(IEvent* ievent) {
 //  IMPL::LCGenericObjectImpl *gclus_ids = static_cast<IMPL::LCGenericObjectImpl *>(lcio_hits_generic->getElementAt(5));
     
   for(int i=0; i < gclus_ix->getNInt(); ++i){
-    clusters_.push_back(new HodoCluster(
-                                        gclus_ix->getIntVal(i),
-                                        gclus_iy->getIntVal(i),
-                                        gclus_layer->getIntVal(i),
-                                        gclus_energy->getDoubleVal(i),
-                                        gclus_time->getDoubleVal(i)));
+    HodoCluster* cluster = cluster_pool_.acquire();
+    cluster->setIndices(gclus_ix->getIntVal(i), gclus_iy->getIntVal(i));
+    cluster->setLayer(gclus_layer->getIntVal(i));
+    cluster->setEnergy(gclus_energy->getDoubleVal(i));
+    cluster->setTime(gclus_time->getDoubleVal(i));
+    clusters_.push_back(cluster);
   }
   
   return true;
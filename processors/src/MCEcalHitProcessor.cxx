@@ -29,7 +29,7 @@ void MCEcalHitProcessor::configure(const ParameterSet& parameters) {
 
 void MCEcalHitProcessor::initialize(TTree* tree) {
 
-    tree->Branch(hitCollRoot_.c_str(), &ecalhits_);
+    addBranch(tree, hitCollRoot_, &ecalhits_);
 }
 
 bool MCEcalHitProcessor::process(IEvent* ievent) {
@@ -28,12 +28,14 @@ void MCParticleProcessor::configure(const ParameterSet& parameters) {
         std::cout << error.what() << std::endl;
     }
 
+    declareConsumes(mcPartCollLcio_);
+    declareProduces(mcPartCollRoot_);
 
 }
 
 void MCParticleProcessor::initialize(TTree* tree) {
     // Add branch to tree
-    tree->Branch(mcPartCollRoot_.c_str(),&mc_particles_);
+    addBranch(tree, mcPartCollRoot_, &mc_particles_);
 
 }
 
@@ -53,15 +55,9 @@ bool MCParticleProcessor::process(IEvent* ievent) {
     }
 
 
-    //Clean up
-    if (mc_particles_.size() > 0 ) 
-    {
-        for (std::vector<MCParticle*>::iterator it = mc_particles_.begin(); it != mc_particles_.end(); ++it) 
-        {
-            delete *it;
-        }
-        mc_particles_.clear();
-    }
+    //Clean up. The particles of the previous event are reused.
+    mc_particles_.clear();
+    mc_particle_pool_.reset();
 
 
     // Loop through all of the particles in the event
@@ -72,7 +68,7 @@ bool MCParticleProcessor::process(IEvent* ievent) {
             = static_cast<IMPL::MCParticleImpl*>(lc_particles->getElementAt(iparticle)); 
 
         // Make an MCParticle to build and add to vector
-        MCParticle* particle = new MCParticle();
+        MCParticle* particle = mc_particle_pool_.acquire();
 
         // Set the charge of the HpsMCParticle    
         particle->setCharge(lc_particle->getCharge());
@@ -29,7 +29,7 @@ void MCTrackerHitProcessor::configure(const ParameterSet& parameters) {
 
 void MCTrackerHitProcessor::initialize(TTree* tree) {
 
-    tree->Branch(hitCollRoot_.c_str(), &trackerhits_);
+    addBranch(tree, hitCollRoot_, &trackerhits_);
 }
 
 bool MCTrackerHitProcessor::process(IEvent* ievent) {
@@ -23,9 +23,9 @@ void RefittedTracksProcessor::configure(const ParameterSet& parameters) {
 
 void RefittedTracksProcessor::initialize(TTree* tree) {
   
-    tree->Branch("GBLRefittedTracks", &tracks_);
-    tree->Branch("V0Vertices", &vertices_);
-    tree->Branch("V0Vertices_refit", &vertices_refit_);
+    addBranch(tree, "GBLRefittedTracks", &tracks_);
+    addBranch(tree, "V0Vertices", &vertices_);
+    addBranch(tree, "V0Vertices_refit", &vertices_refit_);
   
   
     //Original hists
@@ -27,12 +27,16 @@ void SvtRawDataProcessor::configure(const ParameterSet& parameters) {
     {
         std::cout << error.what() << std::endl;
     }
+
+    declareConsumes(hitCollLcio_);
+    declareConsumes(hitfitCollLcio_);
+    declareProduces(hitCollRoot_);
 }
 
 
 void SvtRawDataProcessor::initialize(TTree* tree) {
 
-    tree->Branch(hitCollRoot_.c_str(),&rawhits_);
+    addBranch(tree, hitCollRoot_, &rawhits_);
 }
 
 bool SvtRawDataProcessor::process(IEvent* ievent) {
@@ -71,8 +75,8 @@ bool SvtRawDataProcessor::process(IEvent* ievent) {
 
     // Loop over all of the raw SVT hits in the LCIO event and add them to the 
     // HPS event
-    for(int i = 0; i < rawhits_.size(); i++) delete rawhits_.at(i);
     rawhits_.clear();
+    rawhit_pool_.reset();
 
     for (int ihit = 0; ihit < raw_svt_hits->getNumberOfElements(); ++ihit) {
 
@@ -85,7 +89,7 @@ bool SvtRawDataProcessor::process(IEvent* ievent) {
         decoder.setValue(value);
 
         // Add a raw tracker hit to the event
-        RawSvtHit* rawHit = new RawSvtHit();
+        RawSvtHit* rawHit = rawhit_pool_.acquire();
 
         rawHit->setSystem(decoder["system"]);
         rawHit->setBarrel(decoder["barrel"]);
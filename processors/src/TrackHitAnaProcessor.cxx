@@ -16,6 +16,7 @@ void TrackHitAnaProcessor::configure(const ParameterSet& parameters) {
     {
         debug_                = parameters.getInteger("debug",debug_);
         trkCollName_          = parameters.getString("trkCollName",trkCollName_);
+        hitCollName_          = parameters.getString("hitCollName",hitCollName_);
         histCfgFilename_      = parameters.getString("histCfg",histCfgFilename_);
         doTruth_              = (bool) parameters.getInteger("doTruth",doTruth_);
         truthHistCfgFilename_ = parameters.getString("truthHistCfg",truthHistCfgFilename_);
@@ -38,6 +39,9 @@ void TrackHitAnaProcessor::initialize(TTree* tree) {
     trkHistos_->DefineHistos();
     // Init tree
     tree->SetBranchAddress(trkCollName_.c_str(), &tracks_, &btracks_);
+    // The hits are taken by index from their collection when it is given
+    if (!hitCollName_.empty())
+        tree->SetBranchAddress(hitCollName_.c_str(), &hits_, &bhits_);
     
     if (!selectionCfg_.empty()) {
         trkSelector_ = std::make_shared<BaseSelector>(name_+"_trkSelector",selectionCfg_);
@@ -109,8 +113,8 @@ bool TrackHitAnaProcessor::process(IEvent* ievent) {
 
         std::vector<int> hit_layers;
         int hitCode = 0;
-        for (int ihit = 0; ihit<track->getSvtHits()->GetEntries(); ++ihit) {
-            TrackerHit* hit = (TrackerHit*) track->getSvtHits()->At(ihit);
+        for (int ihit = 0; ihit<track->getNHitLinks(); ++ihit) {
+            TrackerHit* hit = track->getHit(ihit, hits_);
             int layer = hit->getLayer();
             if (isKF)
             {
@@ -26,7 +26,7 @@ void Tracker3DHitProcessor::configure(const ParameterSet& parameters) {
 
 void Tracker3DHitProcessor::initialize(TTree* tree) {
     // Add branches to tree
-    tree->Branch(hitCollRoot_.c_str(), &hits_);
+    addBranch(tree, hitCollRoot_, &hits_);
 }
 
 bool Tracker3DHitProcessor::process(IEvent* ievent) {
@@ -25,6 +25,7 @@ void TrackingProcessor::configure(const ParameterSet& parameters) {
         truthTracksCollLcio_     = parameters.getString("truthTrackCollLcio",truthTracksCollLcio_);
         truthTracksCollRoot_     = parameters.getString("truthTrackCollRoot",truthTracksCollRoot_);
         bfield_                  = parameters.getDouble("bfield",bfield_);
+        storeRefs_               = parameters.getInteger("storeRefs",storeRefs_);
 
         //Residual plotting is done in this processor for the moment.
         doResiduals_             = parameters.getInteger("doResiduals",doResiduals_);
@@ -41,16 +42,16 @@ void TrackingProcessor::configure(const ParameterSet& parameters) {
 }
 
 void TrackingProcessor::initialize(TTree* tree) {
-    tree->Branch(trkCollRoot_.c_str(), &tracks_);
+    addBranch(tree, trkCollRoot_, &tracks_);
     
     if (!trkhitCollRoot_.empty())
-        tree->Branch(trkhitCollRoot_.c_str(), &hits_);
+        addBranch(tree, trkhitCollRoot_, &hits_);
     
     if (!rawhitCollRoot_.empty())
-        tree->Branch(rawhitCollRoot_.c_str(), &rawhits_);
+        addBranch(tree, rawhitCollRoot_, &rawhits_);
     
     if (!truthTracksCollRoot_.empty())
-        tree->Branch(truthTracksCollRoot_.c_str(),&truthTracks_);
+        addBranch(tree, truthTracksCollRoot_, &truthTracks_);
 
 
     //Residual plotting
@@ -66,34 +67,15 @@ void TrackingProcessor::initialize(TTree* tree) {
 
 bool TrackingProcessor::process(IEvent* ievent) {
 
-    //Clean up
-    if (tracks_.size() > 0 ) {
-        for (std::vector<Track *>::iterator it = tracks_.begin(); it != tracks_.end(); ++it) {
-            delete *it;
-        }
-        tracks_.clear();
-    }
-    
-    if (hits_.size() > 0) {
-        for (std::vector<TrackerHit *>::iterator it = hits_.begin(); it != hits_.end(); ++it) {
-            delete *it;
-        }
-        hits_.clear();
-    }
-    
-    if (rawhits_.size() > 0) {
-        for (std::vector<RawSvtHit *>::iterator it = rawhits_.begin(); it != rawhits_.end(); ++it) {
-            delete *it;
-        }
-        rawhits_.clear();
-    }
-    
-    if (truthTracks_.size() > 0) {
-        for (std::vector<Track *>::iterator it = truthTracks_.begin(); it != truthTracks_.end(); ++it) {
-            delete *it;
-        }
-        truthTracks_.clear();
-    }
+    //Clean up. The objects of the previous event are reused.
+    tracks_.clear();
+    track_pool_.reset();
+    hits_.clear();
+    hit_pool_.reset();
+    rawhits_.clear();
+    rawhit_pool_.reset();
+    truthTracks_.clear();
+    truth_track_pool_.reset();
     
     Event* event = static_cast<Event*> (ievent);
     // Get the collection of 3D hits from the LCIO event. If no such collection 
@@ -169,7 +151,7 @@ bool TrackingProcessor::process(IEvent* ievent) {
         }
 
         // Add a track to the event
-        Track* track = utils::buildTrack(lc_track,gbl_kink_data,track_data);
+        Track* track = utils::buildTrack(lc_track,gbl_kink_data,track_data,&track_pool_);
         
         //Override the momentum of the track if the bfield_ > 0
         if (bfield_>0)
@@ -188,21 +170,16 @@ bool TrackingProcessor::process(IEvent* ievent) {
         
         for (auto lc_tracker_hit : lc_tracker_hits) {
             
-            TrackerHit* tracker_hit = utils::buildTrackerHit(static_cast<IMPL::TrackerHitImpl*>(lc_tracker_hit),rotateHits,hitType);
+            TrackerHit* tracker_hit = utils::buildTrackerHit(static_cast<IMPL::TrackerHitImpl*>(lc_tracker_hit),rotateHits,hitType,&hit_pool_);
             
-            std::vector<RawSvtHit*> rawSvthitsOn3d;
+            // The raw hits are linked by their index in rawhits_
             utils::addRawInfoTo3dHit(tracker_hit,static_cast<IMPL::TrackerHitImpl*>(lc_tracker_hit),
-                                     raw_svt_hit_fits,&rawSvthitsOn3d,hitType);
-            
-            for (auto rhit : rawSvthitsOn3d)
-                rawhits_.push_back(rhit);
-
-            rawSvthitsOn3d.clear();
+                                     raw_svt_hit_fits,&rawhits_,hitType,&rawhit_pool_,storeRefs_);
 
             if (debug_)
                 std::cout<<tracker_hit->getRawHits()->GetEntries()<<std::endl;
-            // Add a reference to the hit
-            track->addHit(tracker_hit);
+            // Add a reference to the hit and its index in hits_
+            track->addHit(tracker_hit, hits_.size(), storeRefs_);
             hits_.push_back(tracker_hit);
             
             //Get shared Hits information
@@ -263,7 +240,7 @@ bool TrackingProcessor::process(IEvent* ievent) {
             }
             else {
                 EVENT::Track* lc_truth_track = static_cast<EVENT::Track*> (lc_truth_tracks.at(0));
-                Track* truth_track = utils::buildTrack(lc_truth_track,nullptr,nullptr);
+                Track* truth_track = utils::buildTrack(lc_truth_track,nullptr,nullptr,&truth_track_pool_);
                 track->setTruthLink(truth_track);
                 if (bfield_>0)
                     truth_track->setMomentum(bfield_);
@@ -310,7 +287,7 @@ bool TrackingProcessor::process(IEvent* ievent) {
                     int ly = trackRes_data->getIntVal(i_res);
                     double res = trackRes_data->getDoubleVal(i_res);
                     double sigma = trackRes_data->getFloatVal(i_res);
-                    trkResHistos_->FillResidualHistograms(track,ly,res,sigma);
+                    trkResHistos_->FillResidualHistograms(track,ly,res,sigma,&hits_);
                 }
             }//trackResData exists
         }//doResiduals
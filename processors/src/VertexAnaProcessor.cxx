@@ -26,6 +26,8 @@ void VertexAnaProcessor::configure(const ParameterSet& parameters) {
         vtxColl_ = parameters.getString("vtxColl",vtxColl_);
         trkColl_ = parameters.getString("trkColl",trkColl_);
         hitColl_ = parameters.getString("hitColl",hitColl_);
+        trkHitColl_ = parameters.getString("trkHitColl",trkHitColl_);
+        partColl_ = parameters.getString("partColl",partColl_);
         ecalColl_ = parameters.getString("ecalColl",ecalColl_);
         mcColl_  = parameters.getString("mcColl",mcColl_);
 
@@ -124,6 +126,10 @@ void VertexAnaProcessor::initialize(TTree* tree) {
     //If track collection name is empty take the tracks from the particles. TODO:: change this
     if (!trkColl_.empty())
         tree_->SetBranchAddress(trkColl_.c_str(),&trks_, &btrks_);
+    if (brMap_.find(trkHitColl_.c_str()) != brMap_.end())
+        tree_->SetBranchAddress(trkHitColl_.c_str(), &trkHits_, &btrkHits_);
+    if (brMap_.find(partColl_.c_str()) != brMap_.end())
+        tree_->SetBranchAddress(partColl_.c_str(), &parts_, &bparts_);
 }
 
 bool VertexAnaProcessor::process(IEvent* ievent) {
@@ -155,6 +161,12 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
     _vtx_histos->Fill2DHisto("n_tracks_hh", NeleTrks, NposTrks); 
     _vtx_histos->Fill1DHisto("n_vtx_h", vtxs_->size()); 
 
+    if (!isData_ && !mcColl_.empty()) hps_evt->loadBranch(mcColl_);
+    // The hits are read through the track hit references before the MC matching,
+    // so a lazy hit branch is loaded once up front
+    hps_evt->loadBranch(hitColl_);
+    if (btrkHits_) hps_evt->loadBranch(trkHitColl_);
+    if (bparts_) hps_evt->loadBranch(partColl_);
     if (mcParts_) {
         for(int i = 0; i < mcParts_->size(); i++)
         {
@@ -218,7 +230,7 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
                 break;
         }
 
-        bool foundParts = _ah->GetParticlesFromVtx(vtx,ele,pos);
+        bool foundParts = _ah->GetParticlesFromVtx(vtx,ele,pos,parts_);
         if (!foundParts) {
             if(debug_) std::cout<<"VertexAnaProcessor::WARNING::Found vtx without ele/pos. Skip."<<std::endl;
             continue;
@@ -447,7 +459,7 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
             Particle* ele = nullptr;
             Particle* pos = nullptr;
 
-            _ah->GetParticlesFromVtx(vtx,ele,pos);
+            _ah->GetParticlesFromVtx(vtx,ele,pos,parts_);
 
             CalCluster eleClus = ele->getCluster();
             CalCluster posClus = pos->getCluster();
@@ -509,7 +521,7 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
 
             bool foundL1ele = false;
             bool foundL2ele = false;
-            _ah->InnermostLayerCheck(ele_trk_gbl, foundL1ele, foundL2ele);
+            _ah->InnermostLayerCheck(ele_trk_gbl, foundL1ele, foundL2ele, trkHits_);
 
 
             if (debug_) {
@@ -519,7 +531,7 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
             bool foundL1pos = false;
             bool foundL2pos = false;
 
-            _ah->InnermostLayerCheck(pos_trk_gbl, foundL1pos, foundL2pos);
+            _ah->InnermostLayerCheck(pos_trk_gbl, foundL1pos, foundL2pos, trkHits_);
 
             if (debug_) {
                 std::cout<<"Check on pos_Track"<<std::endl;
@@ -608,19 +620,20 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
                 if (!isData_) _reg_mc_vtx_histos[region]->FillMCParticles(mcParts_, analysis_);
 
                 //Build map of hits and the associated MC part ids for later
-                TRefArray* ele_trk_hits = ele_trk_gbl->getSvtHits();
                 std::map<int, std::vector<int> > trueHitIDs;
                 for(int i = 0; i < hits_->size(); i++)
                 {
                     TrackerHit* hit = hits_->at(i);
                     trueHitIDs[hit->getID()] = hit->getMCPartIDs();
                 }
-                //std::cout << "There are " << ele_trk_hits->GetEntries() << " hits on this track" << std::endl;
+                //std::cout << "There are " << ele_trk_gbl->getNHitLinks() << " hits on this track" << std::endl;
                 //Count the number of hits per part on the track
                 std::map<int, int> nHits4part;
-                for(int i = 0; i < ele_trk_hits->GetEntries(); i++)
+                for(int i = 0; i < ele_trk_gbl->getNHitLinks(); i++)
                 {
-                    TrackerHit* eleHit = (TrackerHit*)ele_trk_hits->At(i);
+                    TrackerHit* eleHit = ele_trk_gbl->getHit(i, trkHits_);
+                    if (!eleHit)
+                        continue;
                     for(int idI = 0; idI < trueHitIDs[eleHit->getID()].size(); idI++ )
                     {
                         int partID = trueHitIDs[eleHit->getID()].at(idI);
@@ -712,7 +725,7 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
         Particle* ele = nullptr;
         Particle* pos = nullptr;
 
-        if (!vtx || !_ah->GetParticlesFromVtx(vtx,ele,pos))
+        if (!vtx || !_ah->GetParticlesFromVtx(vtx,ele,pos,parts_))
             continue;
 
         CalCluster eleClus = ele->getCluster();
@@ -24,6 +24,7 @@ void VertexProcessor::configure(const ParameterSet& parameters) {
         partCollRoot_      = parameters.getString("partCollRoot", partCollRoot_);
         kinkRelCollLcio_   = parameters.getString("kinkRelCollLcio", kinkRelCollLcio_);
         trkRelCollLcio_    = parameters.getString("trkRelCollLcio", trkRelCollLcio_);
+        storeRefs_         = parameters.getInteger("storeRefs", storeRefs_);
         
     }
     catch (std::runtime_error& error)
@@ -34,17 +35,19 @@ void VertexProcessor::configure(const ParameterSet& parameters) {
 
 void VertexProcessor::initialize(TTree* tree) {
     // Add branches to tree
-    tree->Branch(vtxCollRoot_.c_str(),  &vtxs_);
-    tree->Branch(partCollRoot_.c_str(), &parts_);
+    addBranch(tree, vtxCollRoot_, &vtxs_);
+    addBranch(tree, partCollRoot_, &parts_);
 }
 
 bool VertexProcessor::process(IEvent* ievent) {
 
     if (debug_ > 0) std::cout << "VertexProcessor: Clear output vector" << std::endl;
-    for(int i = 0; i < vtxs_.size(); i++) delete vtxs_.at(i);
     vtxs_.clear();
-    for(int i = 0; i < parts_.size(); i++) delete parts_.at(i);
+    vtx_pool_.reset();
     parts_.clear();
+    part_pool_.reset();
+    track_pool_.reset();
+    cluster_pool_.reset();
 
     Event* event = static_cast<Event*> (ievent);
 
@@ -92,17 +95,18 @@ bool VertexProcessor::process(IEvent* ievent) {
         lc_vtx = static_cast<EVENT::Vertex*>(lc_vtxs->getElementAt(ivtx));
 
         if (debug_ > 0) std::cout << "VertexProcessor: Build Vertex" << std::endl;
-        Vertex* vtx = utils::buildVertex(lc_vtx);
+        Vertex* vtx = utils::buildVertex(lc_vtx, &vtx_pool_);
 
         if (debug_ > 0) std::cout << "VertexProcessor: Get Particles" << std::endl;
         std::vector<EVENT::ReconstructedParticle*> lc_parts = lc_vtx->getAssociatedParticle()->getParticles();
         for(auto lc_part : lc_parts)
         {
            if (debug_ > 0) std::cout << "VertexProcessor: Build particle" << std::endl;
-           Particle * part = utils::buildParticle(lc_part, gbl_kink_data, track_data);
+           Particle * part = utils::buildParticle(lc_part, gbl_kink_data, track_data, 
+                   &part_pool_, &track_pool_, &cluster_pool_);
            if (debug_ > 0) std::cout << "VertexProcessor: Add particle" << std::endl;
+            vtx->addParticle(part, parts_.size(), storeRefs_);
             parts_.push_back(part);
-            vtx->addParticle(part);
         }
 
         if (debug_ > 0) std::cout << "VertexProcessor: Add Vertex" << std::endl;
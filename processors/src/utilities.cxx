@@ -28,14 +28,14 @@ bool utils::hasCollection(EVENT::LCEvent* lc_event,const std::string& collection
 }
 
 
-Vertex* utils::buildVertex(EVENT::Vertex* lc_vertex) { 
+Vertex* utils::buildVertex(EVENT::Vertex* lc_vertex, ObjectPool<Vertex>* pool) { 
 
     if (!lc_vertex) 
         return nullptr;
 
     //TODO move the static cast outside?
 
-    Vertex* vertex = new Vertex();
+    Vertex* vertex = pool ? pool->acquire() : new Vertex();
     vertex->setChi2         (lc_vertex->getChi2());
     vertex->setProbability  (lc_vertex->getProbability());
     vertex->setID           (lc_vertex->id());
@@ -55,14 +55,17 @@ Vertex* utils::buildVertex(EVENT::Vertex* lc_vertex) {
 
 Particle* utils::buildParticle(EVENT::ReconstructedParticle* lc_particle,
         EVENT::LCCollection* gbl_kink_data,
-        EVENT::LCCollection* track_data)
+        EVENT::LCCollection* track_data,
+        ObjectPool<Particle>* pool,
+        ObjectPool<Track>* track_pool,
+        ObjectPool<CalCluster>* cluster_pool)
 
 { 
 
     if (!lc_particle) 
         return nullptr;
 
-    Particle* part = new Particle();
+    Particle* part = pool ? pool->acquire() : new Particle();
     // Set the charge of the HpsParticle    
     part->setCharge(lc_particle->getCharge());
 
@@ -86,22 +89,22 @@ Particle* utils::buildParticle(EVENT::ReconstructedParticle* lc_particle,
 
     // Set the Track for the HpsParticle
     if (lc_particle->getTracks().size()>0)
-      part->setTrack(utils::buildTrack(lc_particle->getTracks()[0], gbl_kink_data, track_data));
+      part->setTrack(utils::buildTrack(lc_particle->getTracks()[0], gbl_kink_data, track_data, track_pool));
 
     // Set the Track for the HpsParticle
     if (lc_particle->getClusters().size() > 0)
-        part->setCluster(utils::buildCalCluster(lc_particle->getClusters()[0]));
+        part->setCluster(utils::buildCalCluster(lc_particle->getClusters()[0], cluster_pool));
 
     return part;
 }
 
-CalCluster* utils::buildCalCluster(EVENT::Cluster* lc_cluster) 
+CalCluster* utils::buildCalCluster(EVENT::Cluster* lc_cluster, ObjectPool<CalCluster>* pool) 
 { 
 
     if (!lc_cluster) 
         return nullptr;
 
-    CalCluster* cluster = new CalCluster();
+    CalCluster* cluster = pool ? pool->acquire() : new CalCluster();
     // Set the cluster position
     cluster->setPosition(lc_cluster->getPosition());
 
@@ -148,12 +151,13 @@ bool utils::IsSameTrack(Track* trk1, Track* trk2) {
 
 Track* utils::buildTrack(EVENT::Track* lc_track,
         EVENT::LCCollection* gbl_kink_data,
-        EVENT::LCCollection* track_data) {
+        EVENT::LCCollection* track_data,
+        ObjectPool<Track>* pool) {
 
     if (!lc_track)
         return nullptr;
 
-    Track* track = new Track();
+    Track* track = pool ? pool->acquire() : new Track();
     // Set the track parameters
     track->setTrackParameters(lc_track->getD0(), 
             lc_track->getPhi(), 
@@ -270,14 +274,15 @@ Track* utils::buildTrack(EVENT::Track* lc_track,
 }
 
 RawSvtHit* utils::buildRawHit(EVENT::TrackerRawData* rawTracker_hit,
-        EVENT::LCCollection* raw_svt_hit_fits) {
+        EVENT::LCCollection* raw_svt_hit_fits,
+        ObjectPool<RawSvtHit>* pool) {
 
     EVENT::long64 value =
         EVENT::long64(rawTracker_hit->getCellID0() & 0xffffffff) |
         ( EVENT::long64(rawTracker_hit->getCellID1() ) << 32       );
     decoder.setValue(value);
 
-    RawSvtHit* rawHit = new RawSvtHit();
+    RawSvtHit* rawHit = pool ? pool->acquire() : new RawSvtHit();
     rawHit->setSystem(decoder["system"]);
     rawHit->setBarrel(decoder["barrel"]);
     rawHit->setLayer(decoder["layer"]);
@@ -335,12 +340,13 @@ RawSvtHit* utils::buildRawHit(EVENT::TrackerRawData* rawTracker_hit,
 }//build raw hit
 
 //type = 0 RotatedHelicalTrackHit type = 1 SiCluster
-TrackerHit* utils::buildTrackerHit(IMPL::TrackerHitImpl* lc_tracker_hit, bool rotate, int type) { 
+TrackerHit* utils::buildTrackerHit(IMPL::TrackerHitImpl* lc_tracker_hit, bool rotate, int type,
+        ObjectPool<TrackerHit>* pool) { 
 
     if (!lc_tracker_hit)
         return nullptr;
 
-    TrackerHit* tracker_hit = new TrackerHit();
+    TrackerHit* tracker_hit = pool ? pool->acquire() : new TrackerHit();
 
     // Get the position of the LCIO TrackerHit and set the position of 
     // the TrackerHit
@@ -371,7 +377,8 @@ TrackerHit* utils::buildTrackerHit(IMPL::TrackerHitImpl* lc_tracker_hit, bool ro
 //type 0 rotatedHelicalHit  type 1 SiClusterHit
 bool utils::addRawInfoTo3dHit(TrackerHit* tracker_hit, 
         IMPL::TrackerHitImpl* lc_tracker_hit,
-        EVENT::LCCollection* raw_svt_fits, std::vector<RawSvtHit*>* rawHits,int type) {
+        EVENT::LCCollection* raw_svt_fits, std::vector<RawSvtHit*>* rawHits,int type,
+        ObjectPool<RawSvtHit>* pool, bool ref) {
 
     if (!tracker_hit || !lc_tracker_hit)
         return false;
@@ -388,7 +395,7 @@ bool utils::addRawInfoTo3dHit(TrackerHit* tracker_hit,
     for (unsigned int irh = 0 ; irh < lc_rawHits.size(); ++irh) {
 
         //TODO useless to build all of it?
-        RawSvtHit* rawHit = buildRawHit(static_cast<EVENT::TrackerRawData*>(lc_rawHits.at(irh)),raw_svt_fits); 
+        RawSvtHit* rawHit = buildRawHit(static_cast<EVENT::TrackerRawData*>(lc_rawHits.at(irh)),raw_svt_fits,pool); 
         rawcharge += rawHit->getAmp(0);
         int currentHitVolume = rawHit->getModule() % 2 ? 1 : 0;
         int currentHitLayer  = (rawHit->getLayer() - 1 ) / 2;
@@ -409,9 +416,13 @@ bool utils::addRawInfoTo3dHit(TrackerHit* tracker_hit,
         }
 
         //TODO:: store only if asked
-        tracker_hit->addRawHit(rawHit);
-        if (rawHits)
+        // The raw hits collected in rawHits are also linked by their index
+        if (rawHits) {
+            tracker_hit->addRawHit(rawHit, rawHits->size(), ref);
             rawHits->push_back(rawHit);
+        }
+        else 
+            tracker_hit->addRawHit(rawHit);
 
     }
 
@@ -450,15 +461,19 @@ bool utils::isUsedByTrack(TrackerHit* tracker_hit,
 }
 
 
-bool utils::getParticlesFromVertex(Vertex* vtx, Particle* ele, Particle* pos) {
+bool utils::getParticlesFromVertex(Vertex* vtx, Particle* ele, Particle* pos, 
+        const std::vector<Particle*>* parts) {
 
-    for (int ipart = 0; ipart < vtx->getParticles()->GetEntries(); ++ipart) {
-        int pdg_id = ((Particle*)vtx->getParticles()->At(ipart))->getPDG();
+    for (int ipart = 0; ipart < vtx->getNParticleLinks(); ++ipart) {
+        Particle* part = vtx->getParticle(ipart, parts);
+        if (!part)
+            continue;
+        int pdg_id = part->getPDG();
         if (pdg_id == 11) {
-            ele = (Particle*)vtx->getParticles()->At(ipart);
+            ele = part;
         }
         else if (pdg_id == -11) {
-            pos = (Particle*)vtx->getParticles()->At(ipart);
+            pos = part;
         }
 
         else {
@@ -1,5 +1,6 @@
 #!/bin/bash
 #SBATCH --ntasks=1
+#SBATCH --cpus-per-task=4
 #SBATCH --time=1:00:00
 #SBATCH --mem=6000M
 #SBATCH --partition=shared
@@ -17,4 +18,4 @@ done
 JOBDIR=$(readlink -f $jobdir)
 filename=$(basename -s .root ${JOBDIR}/${run}/2dhistos/hps*${JOB_ID}.root)
 
-hadd ${JOBDIR}/${run}/2dhistos/hps_${run}_bl2dhistos.root ${JOBDIR}/${run}/2dhistos/*bl2dhisto.root
+hpstr-merge -j 4 ${JOBDIR}/${run}/2dhistos/hps_${run}_bl2dhistos.root ${JOBDIR}/${run}/2dhistos/*bl2dhisto.root